@@ -14,7 +14,9 @@ public class PBDSoftBodyPlugin : ModuleRules
             "PBDSoftBodyPlugin/Private/Core",
             "PBDSoftBodyPlugin/Private/Simulation",
             "PBDSoftBodyPlugin/Private/Rendering",
-            "PBDSoftBodyPlugin/Private/Animation"
+            "PBDSoftBodyPlugin/Private/Animation",
+            "PBDSoftBodyPlugin/Private/Cache",
+            "PBDSoftBodyPlugin/Private/Debug"
         });
 
         PublicIncludePaths.Add(System.IO.Path.Combine(ModuleDirectory, "Public"));
@@ -4,27 +4,40 @@
 #include "Rendering/SkinWeightVertexBuffer.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/MorphTarget.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
 #include "SoftBodyCluster.h"
 
-TArray<FVector> UAnimationBlender::GetVertexPositions(UPBDSoftBodyComponent* Component) const
+namespace
 {
-    TArray<FVector> Positions;
+    // Same cut-off the renderer uses for treating a morph target as inactive
+    constexpr float MinMorphTargetWeight = UE_SMALL_NUMBER;
+
+    // Vertices per ParallelFor task in the dual-quaternion pass
+    constexpr int32 SkinningBatchSize = 1024;
+}
+
+bool UAnimationBlender::GetVertexPositions(UPBDSoftBodyComponent* Component, TArray<FVector>& OutPositions)
+{
+    OutPositions.Reset();
     if (!Component)
     {
-        return Positions;
+        return false;
     }
 
     USkeletalMesh* Mesh = Component->GetSkeletalMeshAsset();
     if (!Mesh)
     {
-        if (Component->bEnableDebugLogging && Component->GetOwner())
+        if (Component->bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: GetVertexPositions - No SkeletalMesh assigned to %s."), *Component->GetOwner()->GetName());
+            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: GetVertexPositions - No SkeletalMesh assigned to %s."), *GetNameSafe(Component->GetOwner()));
         }
-        return Positions;
+        return false;
     }
 
-    int32 LODIndex = Component->GetPredictedLODLevel();
+    // Section ranges and clusters are built on the simulation LOD, so skin that LOD rather than the predicted one
+    const int32 LODIndex = UPBDSoftBodyComponent::SimulationLODIndex;
     if (Component->bVerboseDebugLogging)
     {
         UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Using LOD index %d for %s."), LODIndex, *Mesh->GetName());
@@ -39,7 +52,7 @@ TArray<FVector> UAnimationBlender::GetVertexPositions(UPBDSoftBodyComponent* Com
         {
             UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: GetVertexPositions - No LODRenderData for %s at LOD %d."), *Mesh->GetName(), LODIndex);
         }
-        return Positions;
+        return false;
     }
 
     const FSkinWeightVertexBuffer* SkinWeightBuffer = &LODRenderData->SkinWeightVertexBuffer;
@@ -49,16 +62,27 @@ TArray<FVector> UAnimationBlender::GetVertexPositions(UPBDSoftBodyComponent* Com
         {
             UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: GetVertexPositions - Invalid SkinWeightBuffer for %s."), *Mesh->GetName());
         }
-        return Positions;
+        return false;
+    }
+
+    const FPositionVertexBuffer& PositionBuffer = LODRenderData->StaticVertexBuffers.PositionVertexBuffer;
+    const int32 NumVertices = PositionBuffer.GetNumVertices();
+    if (NumVertices != static_cast<int32>(SkinWeightBuffer->GetNumVertices()))
+    {
+        if (Component->bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: Failed to retrieve vertex positions for %s. Vertex count mismatch."), *Mesh->GetName());
+        }
+        return false;
     }
 
-    TArray<FTransform> BoneTransforms = Component->GetComponentSpaceTransforms();
+    const TArray<FTransform>& BoneTransforms = Component->GetSkinningBoneTransforms();
     if (Component->bVerboseDebugLogging)
     {
         UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Retrieved %d bone transforms for %s."), BoneTransforms.Num(), *Mesh->GetName());
     }
 
-    bool bCurrentHasAnimation = (Component->GetAnimInstance() != nullptr && BoneTransforms.Num() > 0);
+    bool bCurrentHasAnimation = ((Component->GetAnimInstance() != nullptr || Component->HasBoneTransformOverride()) && BoneTransforms.Num() > 0);
     if (bCurrentHasAnimation != Component->bHasActiveAnimation)
     {
         Component->bHasActiveAnimation = bCurrentHasAnimation;
@@ -75,85 +99,303 @@ TArray<FVector> UAnimationBlender::GetVertexPositions(UPBDSoftBodyComponent* Com
         }
     }
 
+    // Once the particle layout exists, output goes straight into particle order; before that (during
+    // initialization) it is in render order, with excluded sections neither skinned nor read back (left zero)
+    const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+    const bool bUseLayout = Layout.IsValid();
+    if (bUseLayout)
+    {
+        OutPositions.SetNumUninitialized(Layout.GetNumParticles());
+    }
+    else
+    {
+        OutPositions.SetNumZeroed(NumVertices);
+    }
+
     if (!bCurrentHasAnimation)
     {
-        const FPositionVertexBuffer& PositionBuffer = LODRenderData->StaticVertexBuffers.PositionVertexBuffer;
-        int32 NumVertices = PositionBuffer.GetNumVertices();
-        if (NumVertices == SkinWeightBuffer->GetNumVertices())
+        for (const FSoftBodySectionRange& Range : Component->SectionRanges)
         {
-            Positions.SetNum(NumVertices, EAllowShrinking::No);
-            for (int32 i = 0; i < NumVertices; i++)
+            if (Range.Mode == ESoftBodySectionMode::Excluded)
+            {
+                continue;
+            }
+            const int32 First = bUseLayout ? Range.FirstParticle : Range.FirstVertex;
+            const int32 Count = bUseLayout ? Range.NumParticles : Range.NumVertices;
+            for (int32 OutIdx = First; OutIdx < First + Count; OutIdx++)
             {
-                Positions[i] = FVector(PositionBuffer.VertexPosition(i));
+                const int32 VertexIdx = bUseLayout ? Layout.ParticleToRenderVertex[OutIdx] : OutIdx;
+                OutPositions[OutIdx] = FVector(PositionBuffer.VertexPosition(VertexIdx));
             }
-            if (Component->bEnableDebugLogging && !Component->bHasLoggedVertexCount)
+        }
+
+        // Unskinned, so the morph deltas add as they are
+        const int32 NumMorphed = bUseLayout && Component->bApplyMorphTargets ? AccumulateMorphDeltas(Component, LODIndex, NumVertices) : 0;
+        for (int32 TouchedIdx = 0; TouchedIdx < NumMorphed; TouchedIdx++)
+        {
+            const int32 VertexIdx = MorphTouchedVertices[TouchedIdx];
+            const int32 ParticleIdx = Layout.RenderToParticle[VertexIdx];
+            if (ParticleIdx != INDEX_NONE && Layout.ParticleToRenderVertex[ParticleIdx] == VertexIdx)
             {
-                UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Retrieved %d reference pose vertex positions for %s."), Positions.Num(), *Mesh->GetName());
-                Component->bHasLoggedVertexCount = true;
+                OutPositions[ParticleIdx] += FVector(MorphDeltas[VertexIdx]);
             }
         }
+        Component->SimulationStats.MorphedVertices = NumMorphed;
+
+        if (Component->bEnableDebugLogging && !Component->bHasLoggedVertexCount)
+        {
+            UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Retrieved %d reference pose vertex positions for %s."), OutPositions.Num(), *Mesh->GetName());
+            Component->bHasLoggedVertexCount = true;
+        }
+        return true;
+    }
+
+    const bool bDualQuat = Component->SkinningMode == ESoftBodySkinningMode::DualQuaternion;
+    const float WeightScale = SkinWeightBuffer->Use16BitBoneWeight() ? 1.0f / 65535.0f : 1.0f / 255.0f;
+    // Bone transforms are component space; the rest positions are bind pose, so both modes go through the inverse reference pose
+    if (bDualQuat)
+    {
+        SoftBodySkinning::BuildBoneDualQuats(BoneTransforms, Mesh->GetRefBasesInvMatrix(), BoneDualQuats);
+    }
+    else
+    {
+        SoftBodySkinning::BuildRefToLocals(BoneTransforms, Mesh->GetRefBasesInvMatrix(), RefToLocals);
+    }
+
+    int32 SkinnedCount = 0;
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Excluded)
+        {
+            continue;
+        }
+        const FSkelMeshRenderSection& Section = LODRenderData->RenderSections[Range.SectionIndex];
+        const int32 First = bUseLayout ? Range.FirstParticle : Range.FirstVertex;
+        const int32 Count = bUseLayout ? Range.NumParticles : Range.NumVertices;
+        if (bDualQuat)
+        {
+            // Each batch writes its own contiguous output range
+            const int32 NumBatches = FMath::DivideAndRoundUp(Count, SkinningBatchSize);
+            ParallelFor(NumBatches, [this, &Section, SkinWeightBuffer, &PositionBuffer, &Layout, &OutPositions, bUseLayout, WeightScale, First, Count](int32 BatchIdx)
+            {
+                const int32 BatchEnd = First + FMath::Min((BatchIdx + 1) * SkinningBatchSize, Count);
+                for (int32 OutIdx = First + BatchIdx * SkinningBatchSize; OutIdx < BatchEnd; OutIdx++)
+                {
+                    const int32 VertexIdx = bUseLayout ? Layout.ParticleToRenderVertex[OutIdx] : OutIdx;
+                    OutPositions[OutIdx] = FVector(SoftBodySkinning::SkinPositionDualQuat(GetInfluences(Section, *SkinWeightBuffer, WeightScale, VertexIdx),
+                        BoneDualQuats, PositionBuffer.VertexPosition(VertexIdx)));
+                }
+            }, NumBatches == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+        }
         else
         {
-            if (Component->bEnableDebugLogging)
+            for (int32 OutIdx = First; OutIdx < First + Count; OutIdx++)
             {
-                UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: Failed to retrieve reference pose positions for %s. Vertex count mismatch."), *Mesh->GetName());
+                const int32 VertexIdx = bUseLayout ? Layout.ParticleToRenderVertex[OutIdx] : OutIdx;
+                OutPositions[OutIdx] = FVector(SoftBodySkinning::SkinPositionLinear(GetInfluences(Section, *SkinWeightBuffer, WeightScale, VertexIdx),
+                    RefToLocals, PositionBuffer.VertexPosition(VertexIdx)));
             }
-            return Positions;
         }
-        return Positions;
+        SkinnedCount += Count;
     }
 
-    TArray<FMatrix44f> RefToLocals;
-    RefToLocals.SetNum(BoneTransforms.Num());
-    for (int32 i = 0; i < BoneTransforms.Num(); i++)
+    // Both skinning modes are linear in the rest position for a given vertex, so a morphed vertex only needs its delta
+    // transformed and added on top (linear blend) or its morphed rest position re-skinned (dual quaternion); vertices no
+    // active morph touches cost nothing. Welded duplicates follow the particle's representative vertex.
+    const int32 NumMorphed = bUseLayout && Component->bApplyMorphTargets ? AccumulateMorphDeltas(Component, LODIndex, NumVertices) : 0;
+    for (int32 TouchedIdx = 0; TouchedIdx < NumMorphed; TouchedIdx++)
     {
-        RefToLocals[i] = FMatrix44f(BoneTransforms[i].ToMatrixWithScale());
+        const int32 VertexIdx = MorphTouchedVertices[TouchedIdx];
+        const int32 ParticleIdx = Layout.RenderToParticle[VertexIdx];
+        if (ParticleIdx == INDEX_NONE || Layout.ParticleToRenderVertex[ParticleIdx] != VertexIdx)
+        {
+            continue;
+        }
+        if (const FSoftBodySectionRange* Range = FindParticleSection(Component, ParticleIdx))
+        {
+            const FSoftBodySkinInfluences Influences = GetInfluences(LODRenderData->RenderSections[Range->SectionIndex], *SkinWeightBuffer, WeightScale, VertexIdx);
+            if (bDualQuat)
+            {
+                OutPositions[ParticleIdx] = FVector(SoftBodySkinning::SkinPositionDualQuat(Influences, BoneDualQuats,
+                    PositionBuffer.VertexPosition(VertexIdx) + MorphDeltas[VertexIdx]));
+            }
+            else
+            {
+                OutPositions[ParticleIdx] += FVector(SoftBodySkinning::SkinVectorLinear(Influences, RefToLocals, MorphDeltas[VertexIdx]));
+            }
+        }
     }
+    Component->SimulationStats.MorphedVertices = NumMorphed;
 
-    TArray<FVector3f> SkinnedPositions;
-    USkeletalMeshComponent::ComputeSkinnedPositions(
-        Component,
-        SkinnedPositions,
-        RefToLocals,
-        *LODRenderData,
-        *SkinWeightBuffer
-    );
+    if (Component->bEnableDebugLogging && !Component->bHasLoggedVertexCount)
+    {
+        UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Retrieved %d skinned vertex positions (%d of %d render vertices in skinned sections) for %s."),
+            OutPositions.Num(), SkinnedCount, NumVertices, *Mesh->GetName());
+        Component->bHasLoggedVertexCount = true;
+    }
+    return true;
+}
 
-    if (SkinnedPositions.Num() > 0)
+FSoftBodySkinInfluences UAnimationBlender::GetInfluences(const FSkelMeshRenderSection& Section, const FSkinWeightVertexBuffer& SkinWeightBuffer,
+    float WeightScale, uint32 VertexIndex)
+{
+    FSoftBodySkinInfluences Influences;
+    const uint32 MaxInfluences = FMath::Min<uint32>(SkinWeightBuffer.GetMaxBoneInfluences(), MAX_TOTAL_INFLUENCES);
+    for (uint32 InfluenceIdx = 0; InfluenceIdx < MaxInfluences; InfluenceIdx++)
     {
-        Positions.SetNum(SkinnedPositions.Num(), EAllowShrinking::No);
-        for (int32 i = 0; i < SkinnedPositions.Num(); i++)
+        const uint16 RawWeight = SkinWeightBuffer.GetBoneWeight(VertexIndex, InfluenceIdx);
+        if (RawWeight == 0)
         {
-            Positions[i] = FVector(SkinnedPositions[i].X, SkinnedPositions[i].Y, SkinnedPositions[i].Z);
+            continue;
         }
-        if (Component->bEnableDebugLogging && !Component->bHasLoggedVertexCount)
+        const uint32 SectionBoneIdx = SkinWeightBuffer.GetBoneIndex(VertexIndex, InfluenceIdx);
+        if (!Section.BoneMap.IsValidIndex(SectionBoneIdx))
         {
-            UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Retrieved %d skinned vertex positions for %s."), Positions.Num(), *Mesh->GetName());
-            Component->bHasLoggedVertexCount = true;
+            continue;
         }
+        Influences.Bones[Influences.Num] = Section.BoneMap[SectionBoneIdx];
+        Influences.Weights[Influences.Num] = RawWeight * WeightScale;
+        Influences.Num++;
     }
-    else
+    return Influences;
+}
+
+const FSoftBodySectionRange* UAnimationBlender::FindParticleSection(const UPBDSoftBodyComponent* Component, int32 ParticleIdx)
+{
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
     {
-        if (Component->bEnableDebugLogging)
+        if (Range.Mode != ESoftBodySectionMode::Excluded && ParticleIdx >= Range.FirstParticle && ParticleIdx < Range.FirstParticle + Range.NumParticles)
         {
-            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: Failed to compute skinned positions for %s."), *Mesh->GetName());
+            return &Range;
         }
     }
-    return Positions;
+    return nullptr;
+}
+
+int32 UAnimationBlender::AccumulateMorphDeltas(const UPBDSoftBodyComponent* Component, int32 LODIndex, int32 NumVertices)
+{
+    // Clear only what the previous frame wrote
+    if (MorphDeltas.Num() != NumVertices)
+    {
+        MorphDeltas.SetNumZeroed(NumVertices);
+        MorphTouchedFlags.Init(false, NumVertices);
+        MorphTouchedVertices.Reset();
+    }
+    for (const int32 VertexIdx : MorphTouchedVertices)
+    {
+        MorphDeltas[VertexIdx] = FVector3f::ZeroVector;
+        MorphTouchedFlags[VertexIdx] = false;
+    }
+    MorphTouchedVertices.Reset();
+    LastMorphTargetWeights = Component->MorphTargetWeights;
+
+    for (const TPair<const UMorphTarget*, int32>& ActiveMorph : Component->ActiveMorphTargets)
+    {
+        const UMorphTarget* MorphTarget = ActiveMorph.Key;
+        const float Weight = Component->MorphTargetWeights.IsValidIndex(ActiveMorph.Value) ? Component->MorphTargetWeights[ActiveMorph.Value] : 0.0f;
+        if (!MorphTarget || FMath::Abs(Weight) < MinMorphTargetWeight)
+        {
+            continue;
+        }
+
+        int32 NumDeltas = 0;
+        const FMorphTargetDelta* Deltas = MorphTarget->GetMorphTargetDelta(LODIndex, NumDeltas);
+        for (int32 DeltaIdx = 0; DeltaIdx < NumDeltas; DeltaIdx++)
+        {
+            const FMorphTargetDelta& Delta = Deltas[DeltaIdx];
+            const int32 VertexIdx = static_cast<int32>(Delta.SourceIdx);
+            if (VertexIdx >= NumVertices)
+            {
+                continue;
+            }
+            if (!MorphTouchedFlags[VertexIdx])
+            {
+                MorphTouchedFlags[VertexIdx] = true;
+                MorphTouchedVertices.Add(VertexIdx);
+            }
+            MorphDeltas[VertexIdx] += Delta.PositionDelta * Weight;
+        }
+    }
+    return MorphTouchedVertices.Num();
+}
+
+bool UAnimationBlender::AreMorphTargetWeightsUnchanged(const UPBDSoftBodyComponent* Component) const
+{
+    if (!Component->bApplyMorphTargets)
+    {
+        return true;
+    }
+    const TArray<float>& Current = Component->MorphTargetWeights;
+    if (Current.Num() != LastMorphTargetWeights.Num())
+    {
+        return false;
+    }
+    for (int32 i = 0; i < Current.Num(); i++)
+    {
+        if (!FMath::IsNearlyEqual(Current[i], LastMorphTargetWeights[i], KINDA_SMALL_NUMBER))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UAnimationBlender::AreAllClustersSleeping(const UPBDSoftBodyComponent* Component)
+{
+    for (const FSoftBodyCluster& Cluster : Component->Clusters)
+    {
+        if (!Cluster.bIsSleeping)
+        {
+            return false;
+        }
+    }
+    return Component->Clusters.Num() > 0;
+}
+
+bool UAnimationBlender::AreBoneTransformsUnchanged(const TArray<FTransform>& Current, const TArray<FTransform>& Previous, float TranslationTolerance)
+{
+    if (Current.Num() != Previous.Num() || Current.Num() == 0)
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < Current.Num(); i++)
+    {
+        if (!Current[i].GetTranslation().Equals(Previous[i].GetTranslation(), TranslationTolerance)
+            || !Current[i].GetRotation().Equals(Previous[i].GetRotation(), KINDA_SMALL_NUMBER))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 void UAnimationBlender::UpdateBlendedPositions(UPBDSoftBodyComponent* Component)
 {
     if (!Component || Component->Velocities.Num() == 0 || Component->SimulatedPositions.Num() == 0 || Component->Clusters.Num() == 0)
     {
-        if (Component && Component->bEnableDebugLogging && Component->GetOwner())
+        if (Component && Component->bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: UpdateBlendedPositions - Simulation data not initialized for %s."), *Component->GetOwner()->GetName());
+            UE_LOG(LogTemp, Warning, TEXT("AnimationBlender: UpdateBlendedPositions - Simulation data not initialized for %s."), *GetNameSafe(Component->GetOwner()));
         }
         return;
     }
 
-    TArray<FVector> AnimatedPositions = GetVertexPositions(Component);
+    if (Component->bEnableClusterSleeping && !Component->bResyncToAnimation && AreAllClustersSleeping(Component)
+        && AreBoneTransformsUnchanged(Component->GetSkinningBoneTransforms(), Component->LastSkinnedBoneTransforms, Component->SleepThreshold)
+        && AreMorphTargetWeightsUnchanged(Component))
+    {
+        // Nothing moved since the last skinning pass, so every cluster stays asleep
+        Component->SimulationStats.SleepingClusters = Component->Clusters.Num();
+        Component->SimulationStats.bSkinningSkipped = true;
+        return;
+    }
+
+    TArray<FVector>& AnimatedPositions = Component->AnimatedPositions;
+    const double SkinStartTime = FPlatformTime::Seconds();
+    GetVertexPositions(Component, AnimatedPositions);
+    Component->SimulationStats.SkinTimeMs = static_cast<float>((FPlatformTime::Seconds() - SkinStartTime) * 1000.0);
+    Component->LastSkinnedBoneTransforms = Component->GetSkinningBoneTransforms();
     if (AnimatedPositions.Num() != Component->SimulatedPositions.Num())
     {
         if (Component->bEnableDebugLogging)
@@ -164,41 +406,103 @@ void UAnimationBlender::UpdateBlendedPositions(UPBDSoftBodyComponent* Component)
         return;
     }
 
+    BlendClusters(Component);
+}
+
+void UAnimationBlender::BlendClusters(UPBDSoftBodyComponent* Component)
+{
+    if (!Component || Component->AnimatedPositions.Num() != Component->SimulatedPositions.Num())
+    {
+        return;
+    }
+
+    const TArray<FVector>& AnimatedPositions = Component->AnimatedPositions;
     static int32 FrameCount = 0;
     FrameCount++;
 
+    const float SleepThresholdSq = FMath::Square(Component->SleepThreshold);
+    const bool bResync = Component->bResyncToAnimation;
+    Component->bResyncToAnimation = false;
+
     for (FSoftBodyCluster& Cluster : Component->Clusters)
     {
+        Cluster.bUpdatedThisFrame = false;
+        const int32 ParticleEnd = Cluster.ParticleStart + Cluster.ParticleCount;
         FVector AnimatedCentroid = FVector::ZeroVector;
-        for (int32 VertexIdx : Cluster.VertexIndices)
+        for (int32 ParticleIdx = Cluster.ParticleStart; ParticleIdx < ParticleEnd; ParticleIdx++)
         {
-            AnimatedCentroid += AnimatedPositions[VertexIdx];
+            AnimatedCentroid += AnimatedPositions[ParticleIdx];
         }
-        if (Cluster.VertexIndices.Num() > 0)
+        if (Cluster.ParticleCount > 0)
         {
-            AnimatedCentroid /= Cluster.VertexIndices.Num();
+            AnimatedCentroid /= Cluster.ParticleCount;
         }
         if (Component->bVerboseDebugLogging && (FrameCount % 60 == 0))
         {
             UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Cluster animated centroid at (%.2f, %.2f, %.2f)."),
                 AnimatedCentroid.X, AnimatedCentroid.Y, AnimatedCentroid.Z);
         }
-        Cluster.CentroidPosition = FMath::Lerp(AnimatedCentroid, Cluster.CentroidPosition, Component->SoftBodyBlendWeight);
+
+        if (Cluster.bIsSleeping)
+        {
+            if (!bResync && Component->bEnableClusterSleeping
+                && FVector::DistSquared(AnimatedCentroid, Cluster.SleepAnimatedCentroid) <= SleepThresholdSq)
+            {
+                Component->SimulationStats.SleepingClusters++;
+                continue;
+            }
+            Cluster.WakeUp();
+        }
+
+        const FVector PreviousCentroid = Cluster.CentroidPosition;
+        Cluster.CentroidPosition = bResync
+            ? AnimatedCentroid
+            : FMath::Lerp(AnimatedCentroid, Cluster.CentroidPosition, Component->SoftBodyBlendWeight);
+
+        // Rest offset plus the particle's animated deviation from it (skinning deformation, morph targets): only the
+        // centroid lags behind the animation, the cluster keeps its animated shape
+        FVector* ClusterPositions = Component->SimulatedPositions.GetData() + Cluster.ParticleStart;
+        const FVector* ClusterAnimated = AnimatedPositions.GetData() + Cluster.ParticleStart;
+        for (int32 i = 0; i < Cluster.ParticleCount; i++)
+        {
+            const FVector AnimatedDeviation = ClusterAnimated[i] - AnimatedCentroid - Cluster.VertexOffsets[i];
+            ClusterPositions[i] = Cluster.CentroidPosition + Cluster.VertexOffsets[i] + AnimatedDeviation;
+        }
+        Cluster.bUpdatedThisFrame = true;
+        Component->SimulationStats.SimulatedVertices += Cluster.ParticleCount;
+        Component->SimulationStats.AwakeClusters++;
+
+        const bool bIsStill = FVector::DistSquared(Cluster.CentroidPosition, PreviousCentroid) <= SleepThresholdSq
+            && FVector::DistSquared(AnimatedCentroid, Cluster.LastAnimatedCentroid) <= SleepThresholdSq;
+        Cluster.LastAnimatedCentroid = AnimatedCentroid;
+        if (Component->bEnableClusterSleeping && bIsStill)
+        {
+            if (++Cluster.StillFrameCount >= Component->SleepFrameCount)
+            {
+                Cluster.bIsSleeping = true;
+                Cluster.SleepAnimatedCentroid = AnimatedCentroid;
+            }
+        }
+        else
+        {
+            Cluster.StillFrameCount = 0;
+        }
     }
 
-    for (const FSoftBodyCluster& Cluster : Component->Clusters)
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
     {
-        for (int32 i = 0; i < Cluster.VertexIndices.Num(); i++)
+        if (Range.Mode != ESoftBodySectionMode::Rigid)
         {
-            int32 VertexIdx = Cluster.VertexIndices[i];
-            Component->SimulatedPositions[VertexIdx] = Cluster.CentroidPosition + Cluster.VertexOffsets[i];
+            continue;
         }
+        FMemory::Memcpy(Component->SimulatedPositions.GetData() + Range.FirstParticle, AnimatedPositions.GetData() + Range.FirstParticle, Range.NumParticles * sizeof(FVector));
+        Component->SimulationStats.SimulatedVertices += Range.NumParticles;
     }
 
     if (Component->bEnableDebugLogging && !Component->bHasLoggedBlending)
     {
         UE_LOG(LogTemp, Log, TEXT("AnimationBlender: Blended %d vertices across %d clusters with weight %.2f for %s."),
-            Component->SimulatedPositions.Num(), Component->Clusters.Num(), Component->SoftBodyBlendWeight, *Component->GetOwner()->GetName());
+            Component->SimulatedPositions.Num(), Component->Clusters.Num(), Component->SoftBodyBlendWeight, *GetNameSafe(Component->GetOwner()));
         Component->bHasLoggedBlending = true;
     }
     if (Component->bVerboseDebugLogging && (FrameCount % 60 == 0))
@@ -206,4 +510,10 @@ void UAnimationBlender::UpdateBlendedPositions(UPBDSoftBodyComponent* Component)
         UE_LOG(LogTemp, Log, TEXT("AnimationBlender: First vertex position after blending: (%.2f, %.2f, %.2f)."),
             Component->SimulatedPositions[0].X, Component->SimulatedPositions[0].Y, Component->SimulatedPositions[0].Z);
     }
-}
\ No newline at end of file
+}
+
+SIZE_T UAnimationBlender::GetAllocatedSize() const
+{
+    return MorphDeltas.GetAllocatedSize() + MorphTouchedFlags.GetAllocatedSize() + MorphTouchedVertices.GetAllocatedSize()
+        + RefToLocals.GetAllocatedSize() + BoneDualQuats.GetAllocatedSize() + LastMorphTargetWeights.GetAllocatedSize();
+}
@@ -3,15 +3,51 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "PBDSoftBodyComponent.h"
+#include "SoftBodySkinning.h"
 #include "AnimationBlender.generated.h"
 
+struct FSkelMeshRenderSection;
+class FSkinWeightVertexBuffer;
+
 UCLASS()
 class PBDSOFTBODYPLUGIN_API UAnimationBlender : public UObject
 {
     GENERATED_BODY()
 
 public:
-    // Changed from const to non-const since it modifies Component state
-    TArray<FVector> GetVertexPositions(UPBDSoftBodyComponent* Component) const;
+    // Writes particle-ordered positions once the component's particle layout exists, render-ordered positions before.
+    // Active morph targets are only applied in particle order, so the rest pose captured at initialization stays neutral.
+    bool GetVertexPositions(UPBDSoftBodyComponent* Component, TArray<FVector>& OutPositions);
     void UpdateBlendedPositions(UPBDSoftBodyComponent* Component);
+
+    // The blend half of UpdateBlendedPositions: moves every awake cluster toward the centroid of its AnimatedPositions,
+    // keeping each particle's animated offset from that centroid, and copies rigid sections. AnimatedPositions must already hold this frame's particle-ordered pose.
+    void BlendClusters(UPBDSoftBodyComponent* Component);
+
+    // Heap bytes held by skinning scratch (morph deltas, bone transforms)
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    static bool AreAllClustersSleeping(const UPBDSoftBodyComponent* Component);
+    // Reads the vertex's non-zero weights and maps its section bone indices to skeleton bones
+    static FSoftBodySkinInfluences GetInfluences(const FSkelMeshRenderSection& Section, const FSkinWeightVertexBuffer& SkinWeightBuffer,
+        float WeightScale, uint32 VertexIndex);
+    static const FSoftBodySectionRange* FindParticleSection(const UPBDSoftBodyComponent* Component, int32 ParticleIdx);
+    static bool AreBoneTransformsUnchanged(const TArray<FTransform>& Current, const TArray<FTransform>& Previous, float TranslationTolerance);
+
+    // Sums the deltas of every active, non-zero-weight morph target into MorphDeltas; returns the number of vertices touched
+    int32 AccumulateMorphDeltas(const UPBDSoftBodyComponent* Component, int32 LODIndex, int32 NumVertices);
+    bool AreMorphTargetWeightsUnchanged(const UPBDSoftBodyComponent* Component) const;
+
+    // Render-vertex indexed; only MorphTouchedVertices are non-zero, and only they are cleared on the next frame
+    TArray<FVector3f> MorphDeltas;
+    TBitArray<> MorphTouchedFlags;
+    TArray<int32> MorphTouchedVertices;
+
+    // Ref-to-local skinning transforms, one per bone, rebuilt every skinning pass for the active skinning mode
+    TArray<FMatrix44f> RefToLocals;
+    TArray<FSoftBodyDualQuat> BoneDualQuats;
+
+    // Morph weights used for the last skinning pass, so a fully asleep component still wakes on an expression change
+    TArray<float> LastMorphTargetWeights;
 };
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "SoftBodyBoneRecorder.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+bool FSoftBodyBoneRecording::Load(const FString& FilePath)
+{
+    MeshPath.Reset();
+    NumBones = 0;
+    DeltaTimes.Reset();
+    Bones.Reset();
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: Failed to open %s."), *FilePath);
+        return false;
+    }
+
+    FSoftBodyBoneRecordingHeader FileHeader;
+    Reader->Serialize(&FileHeader, sizeof(FileHeader));
+    if (Reader->IsError() || FileHeader.Magic != FSoftBodyBoneRecordingHeader::RecordingMagic || FileHeader.Version != FSoftBodyBoneRecordingHeader::RecordingVersion
+        || FileHeader.NumBones <= 0 || FileHeader.NumFrames < 0 || FileHeader.MeshPathLength <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: %s is not a valid bone recording (version %u expected)."),
+            *FilePath, FSoftBodyBoneRecordingHeader::RecordingVersion);
+        return false;
+    }
+
+    // A recording that was never stopped (e.g. the session crashed) still has a zero frame count; keep every whole frame
+    const int64 FrameSize = sizeof(float) + static_cast<int64>(FileHeader.NumBones) * sizeof(FSoftBodyRecordedBone);
+    const int64 NumStoredFrames = (Reader->TotalSize() - static_cast<int64>(sizeof(FileHeader)) - FileHeader.MeshPathLength) / FrameSize;
+    if (FileHeader.NumFrames == 0)
+    {
+        FileHeader.NumFrames = static_cast<int32>(FMath::Clamp<int64>(NumStoredFrames, 0, MAX_int32));
+    }
+    if (FileHeader.NumFrames == 0 || NumStoredFrames < FileHeader.NumFrames)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: %s holds %lld of %d frames."), *FilePath, FMath::Max<int64>(NumStoredFrames, 0), FileHeader.NumFrames);
+        return false;
+    }
+
+    TArray<UTF8CHAR> PathChars;
+    PathChars.SetNumUninitialized(FileHeader.MeshPathLength);
+    Reader->Serialize(PathChars.GetData(), PathChars.Num());
+    MeshPath = FString(PathChars.Num(), PathChars.GetData());
+
+    NumBones = FileHeader.NumBones;
+    DeltaTimes.SetNumUninitialized(FileHeader.NumFrames);
+    Bones.SetNumUninitialized(FileHeader.NumFrames * NumBones);
+    for (int32 FrameIdx = 0; FrameIdx < FileHeader.NumFrames; FrameIdx++)
+    {
+        Reader->Serialize(&DeltaTimes[FrameIdx], sizeof(float));
+        Reader->Serialize(&Bones[FrameIdx * NumBones], NumBones * sizeof(FSoftBodyRecordedBone));
+    }
+    if (Reader->IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: %s is truncated."), *FilePath);
+        DeltaTimes.Reset();
+        Bones.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FSoftBodyBoneRecording::GetFrame(int32 FrameIndex, TArray<FTransform>& OutTransforms) const
+{
+    OutTransforms.SetNumUninitialized(NumBones, EAllowShrinking::No);
+    const FSoftBodyRecordedBone* FrameBones = Bones.GetData() + FrameIndex * NumBones;
+    for (int32 BoneIdx = 0; BoneIdx < NumBones; BoneIdx++)
+    {
+        const FSoftBodyRecordedBone& Bone = FrameBones[BoneIdx];
+        OutTransforms[BoneIdx] = FTransform(FQuat(Bone.Rotation), FVector(Bone.Translation), FVector(Bone.Scale));
+    }
+}
+
+void USoftBodyBoneRecorder::BeginDestroy()
+{
+    Stop();
+    Super::BeginDestroy();
+}
+
+bool USoftBodyBoneRecorder::Start(const FString& FilePath, const FString& MeshPath, int32 NumBones)
+{
+    Stop();
+    if (NumBones <= 0 || MeshPath.IsEmpty())
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: Failed to open %s for writing."), *FilePath);
+        return false;
+    }
+
+    const FTCHARToUTF8 PathChars(*MeshPath);
+    Header = FSoftBodyBoneRecordingHeader();
+    Header.NumBones = NumBones;
+    Header.MeshPathLength = PathChars.Length();
+    RecordingPath = FilePath;
+    FrameBones.SetNumUninitialized(NumBones);
+
+    // Header is rewritten with the final frame count on Stop
+    Writer->Serialize(&Header, sizeof(Header));
+    Writer->Serialize(const_cast<void*>(static_cast<const void*>(PathChars.Get())), PathChars.Length());
+    return !Writer->IsError();
+}
+
+bool USoftBodyBoneRecorder::AddFrame(float DeltaTime, const TArray<FTransform>& Transforms)
+{
+    if (!Writer || Transforms.Num() != Header.NumBones)
+    {
+        return false;
+    }
+
+    for (int32 BoneIdx = 0; BoneIdx < Transforms.Num(); BoneIdx++)
+    {
+        const FTransform& Transform = Transforms[BoneIdx];
+        FrameBones[BoneIdx] = { FQuat4f(Transform.GetRotation()), FVector3f(Transform.GetTranslation()), FVector3f(Transform.GetScale3D()) };
+    }
+    Writer->Serialize(&DeltaTime, sizeof(float));
+    Writer->Serialize(FrameBones.GetData(), FrameBones.Num() * sizeof(FSoftBodyRecordedBone));
+    Header.NumFrames++;
+    return !Writer->IsError();
+}
+
+int32 USoftBodyBoneRecorder::Stop()
+{
+    if (!Writer)
+    {
+        return 0;
+    }
+
+    Writer->Seek(0);
+    Writer->Serialize(&Header, sizeof(Header));
+    const bool bFailed = Writer->IsError();
+    Writer->Close();
+    Writer.Reset();
+    FrameBones.Empty();
+
+    if (bFailed)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SoftBodyBoneRecorder: Failed writing %s."), *RecordingPath);
+        return 0;
+    }
+    UE_LOG(LogTemp, Log, TEXT("SoftBodyBoneRecorder: Wrote %d frames of %d bones to %s."), Header.NumFrames, Header.NumBones, *RecordingPath);
+    return Header.NumFrames;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Templates/UniquePtr.h"
+#include "Serialization/Archive.h"
+#include "SoftBodyBoneRecorder.generated.h"
+
+// On-disk layout of a bone transform recording (native endianness):
+//   FSoftBodyBoneRecordingHeader
+//   UTF-8 object path of the recorded skeletal mesh, MeshPathLength bytes, no terminator
+//   per frame: float DeltaTime, then FSoftBodyRecordedBone[NumBones]
+// Transforms are component space, exactly as the skinning pass read them. They are stored in single precision,
+// which is what skinning converts them to anyway.
+struct FSoftBodyBoneRecordingHeader
+{
+    static constexpr uint32 RecordingMagic = 0x52444250; // "PBDR"
+    static constexpr uint32 RecordingVersion = 1;
+
+    uint32 Magic = RecordingMagic;
+    uint32 Version = RecordingVersion;
+    int32 NumBones = 0;
+    int32 NumFrames = 0;
+    int32 MeshPathLength = 0;
+};
+
+struct FSoftBodyRecordedBone
+{
+    FQuat4f Rotation;
+    FVector3f Translation;
+    FVector3f Scale;
+};
+
+// A recording read fully into memory for replay
+struct PBDSOFTBODYPLUGIN_API FSoftBodyBoneRecording
+{
+    bool Load(const FString& FilePath);
+
+    int32 GetNumFrames() const
+    {
+        return DeltaTimes.Num();
+    }
+
+    void GetFrame(int32 FrameIndex, TArray<FTransform>& OutTransforms) const;
+
+    FString MeshPath;
+    int32 NumBones = 0;
+    TArray<float> DeltaTimes;
+    TArray<FSoftBodyRecordedBone> Bones;
+};
+
+// Streams the bone transforms a component skins with to disk, one frame per tick, for replay without the game
+UCLASS()
+class PBDSOFTBODYPLUGIN_API USoftBodyBoneRecorder : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void BeginDestroy() override;
+
+    bool Start(const FString& FilePath, const FString& MeshPath, int32 NumBones);
+
+    // Frames whose bone count differs from the first one are dropped
+    bool AddFrame(float DeltaTime, const TArray<FTransform>& Transforms);
+
+    // Finalizes the header; returns the number of frames written
+    int32 Stop();
+
+    bool IsRecording() const
+    {
+        return Writer.IsValid();
+    }
+
+private:
+    TUniquePtr<FArchive> Writer;
+    FSoftBodyBoneRecordingHeader Header;
+    FString RecordingPath;
+    TArray<FSoftBodyRecordedBone> FrameBones;
+};
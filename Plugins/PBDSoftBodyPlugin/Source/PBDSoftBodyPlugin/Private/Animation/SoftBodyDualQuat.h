@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Unit dual quaternion of a rigid bone transform: Real is the rotation, Dual = 0.5 * Translation * Real.
+// Bone scale is not representable and is dropped.
+struct FSoftBodyDualQuat
+{
+    FQuat4f Real;
+    FQuat4f Dual;
+
+    static FSoftBodyDualQuat FromTransform(const FTransform& Transform)
+    {
+        FSoftBodyDualQuat Result;
+        Result.Real = FQuat4f(Transform.GetRotation().GetNormalized());
+        const FVector3f Translation(Transform.GetTranslation());
+        Result.Dual = (FQuat4f(Translation.X, Translation.Y, Translation.Z, 0.0f) * Result.Real) * 0.5f;
+        return Result;
+    }
+};
+
+namespace SoftBodySkinning
+{
+    // Adds one weighted influence to a running blend. q and -q are the same rotation, so each influence is first
+    // flipped into the pivot's hemisphere to keep the blend on the short arc.
+    FORCEINLINE void AccumulateDualQuat(VectorRegister4Float& BlendReal, VectorRegister4Float& BlendDual, const VectorRegister4Float& Pivot, const FSoftBodyDualQuat& DualQuat, float Weight)
+    {
+        const VectorRegister4Float Real = VectorLoad(&DualQuat.Real.X);
+        const VectorRegister4Float SignedWeight = VectorMultiply(VectorSetFloat1(Weight), VectorSign(VectorDot4(Real, Pivot)));
+        BlendReal = VectorMultiplyAdd(Real, SignedWeight, BlendReal);
+        BlendDual = VectorMultiplyAdd(VectorLoad(&DualQuat.Dual.X), SignedWeight, BlendDual);
+    }
+
+    // Normalizes the blend and applies it as a rigid transform: rotate by Real, translate by the vector part of 2 * Dual * conj(Real)
+    FORCEINLINE FVector3f TransformPosition(const VectorRegister4Float& BlendReal, const VectorRegister4Float& BlendDual, const FVector3f& Position)
+    {
+        const VectorRegister4Float InvLength = VectorReciprocalSqrtAccurate(VectorDot4(BlendReal, BlendReal));
+        const VectorRegister4Float Real = VectorMultiply(BlendReal, InvLength);
+        const VectorRegister4Float Dual = VectorMultiply(BlendDual, InvLength);
+        const VectorRegister4Float Translation = VectorMultiply(VectorQuaternionMultiply2(Dual, VectorQuaternionInverse(Real)), VectorSetFloat1(2.0f));
+        const VectorRegister4Float Rotated = VectorQuaternionRotateVector(Real, VectorLoadFloat3_W0(&Position.X));
+
+        FVector3f Result;
+        VectorStoreFloat3(VectorAdd(Rotated, Translation), &Result.X);
+        return Result;
+    }
+}
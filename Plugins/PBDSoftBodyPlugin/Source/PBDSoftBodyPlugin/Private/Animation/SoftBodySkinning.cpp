@@ -0,0 +1,22 @@
+#include "SoftBodySkinning.h"
+
+void SoftBodySkinning::BuildRefToLocals(TConstArrayView<FTransform> BoneTransforms, TConstArrayView<FMatrix44f> RefBasesInvMatrix, TArray<FMatrix44f>& OutRefToLocals)
+{
+    const int32 NumBones = FMath::Min(BoneTransforms.Num(), RefBasesInvMatrix.Num());
+    OutRefToLocals.SetNumUninitialized(NumBones, EAllowShrinking::No);
+    for (int32 BoneIdx = 0; BoneIdx < NumBones; BoneIdx++)
+    {
+        OutRefToLocals[BoneIdx] = RefBasesInvMatrix[BoneIdx] * FMatrix44f(BoneTransforms[BoneIdx].ToMatrixWithScale());
+    }
+}
+
+void SoftBodySkinning::BuildBoneDualQuats(TConstArrayView<FTransform> BoneTransforms, TConstArrayView<FMatrix44f> RefBasesInvMatrix, TArray<FSoftBodyDualQuat>& OutBoneDualQuats)
+{
+    const int32 NumBones = FMath::Min(BoneTransforms.Num(), RefBasesInvMatrix.Num());
+    OutBoneDualQuats.SetNumUninitialized(NumBones, EAllowShrinking::No);
+    for (int32 BoneIdx = 0; BoneIdx < NumBones; BoneIdx++)
+    {
+        const FTransform InvRefPose(FMatrix(RefBasesInvMatrix[BoneIdx]));
+        OutBoneDualQuats[BoneIdx] = FSoftBodyDualQuat::FromTransform(InvRefPose * BoneTransforms[BoneIdx]);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GPUSkinPublicDefs.h"
+#include "SoftBodyDualQuat.h"
+
+// Bone influences of one vertex, resolved to skeleton bone indices, with weights already scaled to [0, 1]
+struct FSoftBodySkinInfluences
+{
+    int32 Bones[MAX_TOTAL_INFLUENCES];
+    float Weights[MAX_TOTAL_INFLUENCES];
+    int32 Num = 0;
+};
+
+namespace SoftBodySkinning
+{
+    // Skinning matrices: each bone's inverse reference pose composed with its component-space transform, so a
+    // rest-pose vertex goes to bind space and back out with the bone. Bones missing from either array are left out.
+    void BuildRefToLocals(TConstArrayView<FTransform> BoneTransforms, TConstArrayView<FMatrix44f> RefBasesInvMatrix, TArray<FMatrix44f>& OutRefToLocals);
+
+    // The same ref-to-local transforms as unit dual quaternions (scale dropped)
+    void BuildBoneDualQuats(TConstArrayView<FTransform> BoneTransforms, TConstArrayView<FMatrix44f> RefBasesInvMatrix, TArray<FSoftBodyDualQuat>& OutBoneDualQuats);
+
+    FORCEINLINE FVector3f SkinPositionLinear(const FSoftBodySkinInfluences& Influences, const TArray<FMatrix44f>& RefToLocals, const FVector3f& RestPosition)
+    {
+        FVector3f SkinnedPosition = FVector3f::ZeroVector;
+        for (int32 InfluenceIdx = 0; InfluenceIdx < Influences.Num; InfluenceIdx++)
+        {
+            if (RefToLocals.IsValidIndex(Influences.Bones[InfluenceIdx]))
+            {
+                SkinnedPosition += RefToLocals[Influences.Bones[InfluenceIdx]].TransformPosition(RestPosition) * Influences.Weights[InfluenceIdx];
+            }
+        }
+        return SkinnedPosition;
+    }
+
+    // Linear blend of a direction or offset (no translation), e.g. a morph delta
+    FORCEINLINE FVector3f SkinVectorLinear(const FSoftBodySkinInfluences& Influences, const TArray<FMatrix44f>& RefToLocals, const FVector3f& Vector)
+    {
+        FVector3f SkinnedVector = FVector3f::ZeroVector;
+        for (int32 InfluenceIdx = 0; InfluenceIdx < Influences.Num; InfluenceIdx++)
+        {
+            if (RefToLocals.IsValidIndex(Influences.Bones[InfluenceIdx]))
+            {
+                SkinnedVector += RefToLocals[Influences.Bones[InfluenceIdx]].TransformVector(Vector) * Influences.Weights[InfluenceIdx];
+            }
+        }
+        return SkinnedVector;
+    }
+
+    FORCEINLINE FVector3f SkinPositionDualQuat(const FSoftBodySkinInfluences& Influences, const TArray<FSoftBodyDualQuat>& BoneDualQuats, const FVector3f& RestPosition)
+    {
+        VectorRegister4Float BlendReal = VectorZeroFloat();
+        VectorRegister4Float BlendDual = VectorZeroFloat();
+        VectorRegister4Float Pivot = VectorZeroFloat();
+        bool bHasInfluence = false;
+        for (int32 InfluenceIdx = 0; InfluenceIdx < Influences.Num; InfluenceIdx++)
+        {
+            if (!BoneDualQuats.IsValidIndex(Influences.Bones[InfluenceIdx]))
+            {
+                continue;
+            }
+            const FSoftBodyDualQuat& DualQuat = BoneDualQuats[Influences.Bones[InfluenceIdx]];
+            if (!bHasInfluence)
+            {
+                Pivot = VectorLoad(&DualQuat.Real.X);
+                bHasInfluence = true;
+            }
+            AccumulateDualQuat(BlendReal, BlendDual, Pivot, DualQuat, Influences.Weights[InfluenceIdx]);
+        }
+        return bHasInfluence ? TransformPosition(BlendReal, BlendDual, RestPosition) : FVector3f::ZeroVector;
+    }
+}
@@ -0,0 +1,395 @@
+#include "VertexDeltaCache.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+namespace VertexDeltaCache
+{
+    // Residuals below this (cm) are treated as zero and the cluster's residual block is skipped for the frame
+    static constexpr double ResidualEpsilon = 1.0e-4;
+
+    static void WriteRaw(FArchive& Ar, const void* Data, int64 Bytes)
+    {
+        Ar.Serialize(const_cast<void*>(Data), Bytes);
+    }
+}
+
+FVertexDeltaCacheWriter::~FVertexDeltaCacheWriter()
+{
+    if (Writer)
+    {
+        Close();
+    }
+}
+
+bool FVertexDeltaCacheWriter::Open(const FString& FilePath, const TArray<FSoftBodyDeltaCacheClusterRange>& InClusterRanges, const TArray<FVector3f>& InRestOffsets,
+    float FrameRate, int32 FramesPerChunk)
+{
+    if (InClusterRanges.Num() == 0 || InRestOffsets.Num() == 0 || FrameRate <= 0.0f || FramesPerChunk <= 0)
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VertexDeltaCache: Failed to open %s for writing."), *FilePath);
+        return false;
+    }
+
+    Header = FSoftBodyDeltaCacheHeader();
+    Header.NumParticles = InRestOffsets.Num();
+    Header.NumClusters = InClusterRanges.Num();
+    Header.FramesPerChunk = FramesPerChunk;
+    Header.FrameRate = FrameRate;
+    ClusterRanges = InClusterRanges;
+    RestOffsets = InRestOffsets;
+    Chunks.Reset();
+    ChunkData.Reset();
+    ChunkFrameOffsets.Reset();
+    BytesWritten = 0;
+
+    // Header is rewritten with the final frame count and chunk table offset on Close
+    VertexDeltaCache::WriteRaw(*Writer, &Header, sizeof(Header));
+    VertexDeltaCache::WriteRaw(*Writer, ClusterRanges.GetData(), ClusterRanges.Num() * sizeof(FSoftBodyDeltaCacheClusterRange));
+    VertexDeltaCache::WriteRaw(*Writer, RestOffsets.GetData(), RestOffsets.Num() * sizeof(FVector3f));
+    return !Writer->IsError();
+}
+
+bool FVertexDeltaCacheWriter::AddFrame(const TArray<FVector>& Positions)
+{
+    if (!Writer || Positions.Num() != Header.NumParticles)
+    {
+        return false;
+    }
+
+    const int32 FrameStart = ChunkData.Num();
+    ChunkFrameOffsets.Add(FrameStart);
+
+    const int32 NumClusters = ClusterRanges.Num();
+    ChunkData.AddUninitialized(NumClusters * (sizeof(FVector3f) + sizeof(float)));
+
+    for (int32 ClusterIdx = 0; ClusterIdx < NumClusters; ClusterIdx++)
+    {
+        const FSoftBodyDeltaCacheClusterRange& Range = ClusterRanges[ClusterIdx];
+        FVector Centroid = FVector::ZeroVector;
+        for (int32 ParticleIdx = Range.ParticleStart; ParticleIdx < Range.ParticleStart + Range.ParticleCount; ParticleIdx++)
+        {
+            Centroid += Positions[ParticleIdx];
+        }
+        if (Range.ParticleCount > 0)
+        {
+            Centroid /= Range.ParticleCount;
+        }
+
+        double MaxResidual = 0.0;
+        for (int32 ParticleIdx = Range.ParticleStart; ParticleIdx < Range.ParticleStart + Range.ParticleCount; ParticleIdx++)
+        {
+            MaxResidual = FMath::Max(MaxResidual, (Positions[ParticleIdx] - Centroid - FVector(RestOffsets[ParticleIdx])).GetAbsMax());
+        }
+
+        // Re-resolved every iteration: the residual appends below may reallocate ChunkData
+        FVector3f* Centroids = reinterpret_cast<FVector3f*>(ChunkData.GetData() + FrameStart);
+        float* Scales = reinterpret_cast<float*>(Centroids + NumClusters);
+        Centroids[ClusterIdx] = FVector3f(Centroid);
+        Scales[ClusterIdx] = MaxResidual > VertexDeltaCache::ResidualEpsilon ? static_cast<float>(MaxResidual / MAX_int16) : 0.0f;
+        if (Scales[ClusterIdx] == 0.0f)
+        {
+            continue;
+        }
+
+        const double InvScale = 1.0 / Scales[ClusterIdx];
+        const FVector StoredCentroid(Centroids[ClusterIdx]);
+        const int32 ResidualStart = ChunkData.Num();
+        ChunkData.AddUninitialized(Range.ParticleCount * 3 * sizeof(int16));
+        int16* Residuals = reinterpret_cast<int16*>(ChunkData.GetData() + ResidualStart);
+        for (int32 ParticleIdx = Range.ParticleStart; ParticleIdx < Range.ParticleStart + Range.ParticleCount; ParticleIdx++)
+        {
+            // Quantize against the stored float centroid so the decoder reproduces the same base
+            const FVector Residual = (Positions[ParticleIdx] - StoredCentroid - FVector(RestOffsets[ParticleIdx])) * InvScale;
+            *Residuals++ = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Residual.X), -MAX_int16, MAX_int16));
+            *Residuals++ = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Residual.Y), -MAX_int16, MAX_int16));
+            *Residuals++ = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Residual.Z), -MAX_int16, MAX_int16));
+        }
+    }
+
+    // Keep every frame 4-byte aligned for the float reads on playback
+    ChunkData.AddZeroed(Align(ChunkData.Num(), 4) - ChunkData.Num());
+    Header.NumFrames++;
+
+    if (ChunkFrameOffsets.Num() == Header.FramesPerChunk)
+    {
+        FlushChunk();
+    }
+    return !Writer->IsError();
+}
+
+void FVertexDeltaCacheWriter::FlushChunk()
+{
+    if (ChunkFrameOffsets.Num() == 0)
+    {
+        return;
+    }
+
+    // Frame offsets are stored relative to the chunk start; the table is always FramesPerChunk entries long
+    const uint32 TableBytes = Header.FramesPerChunk * sizeof(uint32);
+    TArray<uint32> FrameTable;
+    FrameTable.SetNumZeroed(Header.FramesPerChunk);
+    for (int32 i = 0; i < ChunkFrameOffsets.Num(); i++)
+    {
+        FrameTable[i] = TableBytes + ChunkFrameOffsets[i];
+    }
+
+    FSoftBodyDeltaCacheChunk& Chunk = Chunks.AddDefaulted_GetRef();
+    Chunk.Offset = Writer->Tell();
+    VertexDeltaCache::WriteRaw(*Writer, FrameTable.GetData(), TableBytes);
+    VertexDeltaCache::WriteRaw(*Writer, ChunkData.GetData(), ChunkData.Num());
+    Chunk.Size = Writer->Tell() - Chunk.Offset;
+
+    ChunkData.Reset();
+    ChunkFrameOffsets.Reset();
+}
+
+bool FVertexDeltaCacheWriter::Close()
+{
+    if (!Writer)
+    {
+        return false;
+    }
+
+    FlushChunk();
+    Header.NumChunks = Chunks.Num();
+    Header.ChunkTableOffset = Writer->Tell();
+    VertexDeltaCache::WriteRaw(*Writer, Chunks.GetData(), Chunks.Num() * sizeof(FSoftBodyDeltaCacheChunk));
+    BytesWritten = Writer->Tell();
+
+    Writer->Seek(0);
+    VertexDeltaCache::WriteRaw(*Writer, &Header, sizeof(Header));
+    const bool bSuccess = Writer->Close() && Header.NumFrames > 0;
+    Writer.Reset();
+    return bSuccess;
+}
+
+int64 FVertexDeltaCacheWriter::GetBytesWritten() const
+{
+    return Writer ? Writer->Tell() : BytesWritten;
+}
+
+void UVertexDeltaCache::BeginDestroy()
+{
+    Close();
+    Super::BeginDestroy();
+}
+
+bool UVertexDeltaCache::Open(const FString& FilePath)
+{
+    Close();
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VertexDeltaCache: Failed to open %s."), *FilePath);
+        return false;
+    }
+
+    FSoftBodyDeltaCacheHeader FileHeader;
+    Reader->Serialize(&FileHeader, sizeof(FileHeader));
+    if (Reader->IsError() || FileHeader.Magic != FSoftBodyDeltaCacheHeader::CacheMagic || FileHeader.Version != FSoftBodyDeltaCacheHeader::CacheVersion
+        || FileHeader.NumFrames <= 0 || FileHeader.NumParticles <= 0 || FileHeader.NumClusters <= 0 || FileHeader.FramesPerChunk <= 0
+        || FileHeader.NumChunks != FMath::DivideAndRoundUp(FileHeader.NumFrames, FileHeader.FramesPerChunk))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VertexDeltaCache: %s is not a valid vertex-delta cache (version %u expected)."),
+            *FilePath, FSoftBodyDeltaCacheHeader::CacheVersion);
+        return false;
+    }
+
+    ClusterRanges.SetNumUninitialized(FileHeader.NumClusters);
+    Reader->Serialize(ClusterRanges.GetData(), ClusterRanges.Num() * sizeof(FSoftBodyDeltaCacheClusterRange));
+    RestOffsets.SetNumUninitialized(FileHeader.NumParticles);
+    Reader->Serialize(RestOffsets.GetData(), RestOffsets.Num() * sizeof(FVector3f));
+    Reader->Seek(FileHeader.ChunkTableOffset);
+    Chunks.SetNumUninitialized(FileHeader.NumChunks);
+    Reader->Serialize(Chunks.GetData(), Chunks.Num() * sizeof(FSoftBodyDeltaCacheChunk));
+    if (Reader->IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VertexDeltaCache: %s is truncated."), *FilePath);
+        ClusterRanges.Reset();
+        RestOffsets.Reset();
+        Chunks.Reset();
+        return false;
+    }
+
+    // Decoding indexes positions by these ranges and chunks by these extents without further checks
+    const uint64 FileSize = static_cast<uint64>(Reader->TotalSize());
+    const uint64 TableBytes = static_cast<uint64>(FileHeader.FramesPerChunk) * sizeof(uint32);
+    bool bValidLayout = true;
+    for (const FSoftBodyDeltaCacheClusterRange& Range : ClusterRanges)
+    {
+        bValidLayout &= Range.ParticleStart >= 0 && Range.ParticleCount >= 0 && Range.ParticleCount <= FileHeader.NumParticles - Range.ParticleStart;
+    }
+    for (const FSoftBodyDeltaCacheChunk& Chunk : Chunks)
+    {
+        bValidLayout &= Chunk.Size >= TableBytes && Chunk.Offset <= FileSize && Chunk.Size <= FileSize - Chunk.Offset;
+    }
+    if (!bValidLayout)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VertexDeltaCache: %s has cluster ranges or chunks outside the file."), *FilePath);
+        ClusterRanges.Reset();
+        RestOffsets.Reset();
+        Chunks.Reset();
+        return false;
+    }
+    Reader->Close();
+
+    // Frame data stays on disk; chunks are mapped one at a time as playback reaches them
+    MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    CachePath = FilePath;
+    Header = FileHeader;
+    return true;
+}
+
+void UVertexDeltaCache::Close()
+{
+    MappedChunk.Reset();
+    MappedFile.Reset();
+    ChunkBuffer.Empty();
+    ClusterRanges.Empty();
+    RestOffsets.Empty();
+    Chunks.Empty();
+    CurrentChunk = INDEX_NONE;
+    Header = FSoftBodyDeltaCacheHeader();
+}
+
+bool UVertexDeltaCache::IsCompatible(int32 NumParticles, const TArray<FSoftBodyDeltaCacheClusterRange>& InClusterRanges) const
+{
+    if (!IsOpen() || NumParticles != Header.NumParticles || InClusterRanges.Num() != ClusterRanges.Num())
+    {
+        return false;
+    }
+    return FMemory::Memcmp(InClusterRanges.GetData(), ClusterRanges.GetData(), ClusterRanges.Num() * sizeof(FSoftBodyDeltaCacheClusterRange)) == 0;
+}
+
+int32 UVertexDeltaCache::GetFrameAtTime(float Time, bool bLoop) const
+{
+    if (!IsOpen())
+    {
+        return INDEX_NONE;
+    }
+    const int32 Frame = FMath::Max(FMath::FloorToInt(Time * Header.FrameRate), 0);
+    return bLoop ? Frame % Header.NumFrames : FMath::Min(Frame, Header.NumFrames - 1);
+}
+
+const uint8* UVertexDeltaCache::AcquireChunk(int32 ChunkIndex)
+{
+    if (ChunkIndex == CurrentChunk)
+    {
+        return MappedChunk ? MappedChunk->GetMappedPtr() : ChunkBuffer.GetData();
+    }
+
+    const FSoftBodyDeltaCacheChunk& Chunk = Chunks[ChunkIndex];
+    MappedChunk.Reset();
+    CurrentChunk = INDEX_NONE;
+    if (MappedFile)
+    {
+        MappedChunk.Reset(MappedFile->MapRegion(Chunk.Offset, Chunk.Size));
+        if (MappedChunk)
+        {
+            CurrentChunk = ChunkIndex;
+            return MappedChunk->GetMappedPtr();
+        }
+    }
+
+    // No memory mapping on this platform (or it failed): stream the chunk into a buffer instead
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*CachePath));
+    if (!Reader)
+    {
+        return nullptr;
+    }
+    ChunkBuffer.SetNumUninitialized(Chunk.Size, EAllowShrinking::No);
+    Reader->Seek(Chunk.Offset);
+    Reader->Serialize(ChunkBuffer.GetData(), Chunk.Size);
+    if (Reader->IsError())
+    {
+        return nullptr;
+    }
+    CurrentChunk = ChunkIndex;
+    return ChunkBuffer.GetData();
+}
+
+bool UVertexDeltaCache::DecodeFrame(int32 FrameIndex, TArray<FVector>& OutPositions)
+{
+    if (!IsOpen() || FrameIndex < 0 || FrameIndex >= Header.NumFrames || OutPositions.Num() != Header.NumParticles)
+    {
+        return false;
+    }
+
+    const int32 ChunkIndex = FrameIndex / Header.FramesPerChunk;
+    const uint8* Chunk = AcquireChunk(ChunkIndex);
+    if (!Chunk)
+    {
+        return false;
+    }
+
+    // The frame offset and the residual blocks it leads to come from the file; a frame that would read past its chunk
+    // is rejected rather than decoded
+    const uint64 ChunkSize = Chunks[ChunkIndex].Size;
+    const uint64 TableBytes = static_cast<uint64>(Header.FramesPerChunk) * sizeof(uint32);
+    const uint64 FrameOffset = reinterpret_cast<const uint32*>(Chunk)[FrameIndex % Header.FramesPerChunk];
+    const uint64 FrameHeaderBytes = static_cast<uint64>(Header.NumClusters) * (sizeof(FVector3f) + sizeof(float));
+    if (FrameOffset < TableBytes || FrameOffset % 4 != 0 || FrameOffset + FrameHeaderBytes > ChunkSize)
+    {
+        return false;
+    }
+    const uint8* Frame = Chunk + FrameOffset;
+    const FVector3f* Centroids = reinterpret_cast<const FVector3f*>(Frame);
+    const float* Scales = reinterpret_cast<const float*>(Centroids + Header.NumClusters);
+    const int16* Residuals = reinterpret_cast<const int16*>(Scales + Header.NumClusters);
+
+    uint64 ResidualBytes = 0;
+    for (int32 ClusterIdx = 0; ClusterIdx < Header.NumClusters; ClusterIdx++)
+    {
+        ResidualBytes += Scales[ClusterIdx] != 0.0f ? static_cast<uint64>(ClusterRanges[ClusterIdx].ParticleCount) * 3 * sizeof(int16) : 0;
+    }
+    if (ResidualBytes > ChunkSize - FrameOffset - FrameHeaderBytes)
+    {
+        return false;
+    }
+
+    FVector* Positions = OutPositions.GetData();
+    const FVector3f* Offsets = RestOffsets.GetData();
+    for (int32 ClusterIdx = 0; ClusterIdx < Header.NumClusters; ClusterIdx++)
+    {
+        const FSoftBodyDeltaCacheClusterRange& Range = ClusterRanges[ClusterIdx];
+        const FVector3f& Centroid = Centroids[ClusterIdx];
+        const float Scale = Scales[ClusterIdx];
+        const int32 ParticleEnd = Range.ParticleStart + Range.ParticleCount;
+        if (Scale == 0.0f)
+        {
+            for (int32 ParticleIdx = Range.ParticleStart; ParticleIdx < ParticleEnd; ParticleIdx++)
+            {
+                Positions[ParticleIdx] = FVector(Centroid + Offsets[ParticleIdx]);
+            }
+            continue;
+        }
+        for (int32 ParticleIdx = Range.ParticleStart; ParticleIdx < ParticleEnd; ParticleIdx++, Residuals += 3)
+        {
+            Positions[ParticleIdx] = FVector(Centroid + Offsets[ParticleIdx] + FVector3f(Residuals[0], Residuals[1], Residuals[2]) * Scale);
+        }
+    }
+    return true;
+}
+
+SIZE_T UVertexDeltaCache::GetMappedSize() const
+{
+    if (CurrentChunk == INDEX_NONE)
+    {
+        return 0;
+    }
+    return MappedChunk ? static_cast<SIZE_T>(Chunks[CurrentChunk].Size) : ChunkBuffer.GetAllocatedSize();
+}
+
+SIZE_T UVertexDeltaCache::GetAllocatedSize() const
+{
+    return ClusterRanges.GetAllocatedSize() + RestOffsets.GetAllocatedSize() + Chunks.GetAllocatedSize();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Templates/UniquePtr.h"
+#include "Serialization/Archive.h"
+#include "Async/MappedFileHandle.h"
+#include "VertexDeltaCache.generated.h"
+
+// On-disk layout of a baked vertex-delta cache (native endianness):
+//   FSoftBodyDeltaCacheHeader
+//   int32 ParticleStart, ParticleCount per cluster
+//   FVector3f rest offset per particle, relative to its cluster's centroid
+//   chunks of FramesPerChunk frames, each starting with one uint32 frame offset per frame (relative to the chunk)
+//   FSoftBodyDeltaCacheChunk per chunk, at ChunkTableOffset
+// A frame is one FVector3f centroid and one float residual scale per cluster, then int16 XYZ residuals for
+// every particle of the clusters whose scale is non-zero, padded to 4 bytes.
+// Particle position = centroid + rest offset + residual * scale.
+struct FSoftBodyDeltaCacheHeader
+{
+    static constexpr uint32 CacheMagic = 0x43444250; // "PBDC"
+    static constexpr uint32 CacheVersion = 1;
+
+    uint32 Magic = CacheMagic;
+    uint32 Version = CacheVersion;
+    int32 NumParticles = 0;
+    int32 NumClusters = 0;
+    int32 NumFrames = 0;
+    int32 FramesPerChunk = 0;
+    int32 NumChunks = 0;
+    float FrameRate = 0.0f;
+    uint64 ChunkTableOffset = 0;
+};
+
+struct FSoftBodyDeltaCacheChunk
+{
+    uint64 Offset = 0;
+    uint64 Size = 0;
+};
+
+struct FSoftBodyDeltaCacheClusterRange
+{
+    int32 ParticleStart = 0;
+    int32 ParticleCount = 0;
+};
+
+// Streams frames to disk one chunk at a time, so a bake never holds more than FramesPerChunk frames in memory
+class PBDSOFTBODYPLUGIN_API FVertexDeltaCacheWriter
+{
+public:
+    ~FVertexDeltaCacheWriter();
+
+    bool Open(const FString& FilePath, const TArray<FSoftBodyDeltaCacheClusterRange>& InClusterRanges, const TArray<FVector3f>& InRestOffsets,
+        float FrameRate, int32 FramesPerChunk);
+    bool AddFrame(const TArray<FVector>& Positions);
+    bool Close();
+
+    int64 GetBytesWritten() const;
+
+private:
+    void FlushChunk();
+
+    TUniquePtr<FArchive> Writer;
+    FSoftBodyDeltaCacheHeader Header;
+    TArray<FSoftBodyDeltaCacheClusterRange> ClusterRanges;
+    TArray<FVector3f> RestOffsets;
+    TArray<FSoftBodyDeltaCacheChunk> Chunks;
+    TArray<uint8> ChunkData;
+    TArray<uint32> ChunkFrameOffsets;
+    int64 BytesWritten = 0;
+};
+
+// Plays a baked cache back by decoding frames straight out of memory-mapped chunks
+UCLASS()
+class PBDSOFTBODYPLUGIN_API UVertexDeltaCache : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void BeginDestroy() override;
+
+    bool Open(const FString& FilePath);
+    void Close();
+    bool IsOpen() const { return Header.NumFrames > 0; }
+
+    // Checks the cache was baked from the same particle layout and clustering
+    bool IsCompatible(int32 NumParticles, const TArray<FSoftBodyDeltaCacheClusterRange>& InClusterRanges) const;
+
+    int32 GetNumFrames() const { return Header.NumFrames; }
+    int32 GetFrameAtTime(float Time, bool bLoop = true) const;
+
+    // Writes the frame's particle-ordered positions; OutPositions must already hold NumParticles entries.
+    // Returns false, writing nothing, if the frame's data would run past its chunk.
+    bool DecodeFrame(int32 FrameIndex, TArray<FVector>& OutPositions);
+
+    SIZE_T GetMappedSize() const;
+
+    // Heap bytes held by the tables; the resident chunk, mapped or read into a buffer, is reported by GetMappedSize
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    const uint8* AcquireChunk(int32 ChunkIndex);
+
+    FSoftBodyDeltaCacheHeader Header;
+    FString CachePath;
+    TArray<FSoftBodyDeltaCacheClusterRange> ClusterRanges;
+    TArray<FVector3f> RestOffsets;
+    TArray<FSoftBodyDeltaCacheChunk> Chunks;
+
+    // Current chunk: mapped when the platform supports it, otherwise read into ChunkBuffer
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedChunk;
+    TArray<uint8> ChunkBuffer;
+    int32 CurrentChunk = INDEX_NONE;
+};
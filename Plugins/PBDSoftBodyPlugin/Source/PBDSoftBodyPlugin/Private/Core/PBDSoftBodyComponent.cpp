@@ -1,10 +1,20 @@
 #include "PBDSoftBodyComponent.h"
+#include "PBDSoftBodyPlugin.h"
 #include "PBDSoftBodyPlugin/Private/Simulation/ClusterManager.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySnapshot.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
 #include "PBDSoftBodyPlugin/Private/Rendering/VertexBufferUpdater.h"
 #include "PBDSoftBodyPlugin/Private/Animation/AnimationBlender.h"
+#include "PBDSoftBodyPlugin/Private/Animation/SoftBodyBoneRecorder.h"
+#include "PBDSoftBodyPlugin/Private/Cache/VertexDeltaCache.h"
+#include "PBDSoftBodyPlugin/Private/Debug/SoftBodyDebugDrawComponent.h"
+#include "PBDSoftBodyPlugin/Private/Core/SoftBodyInstancePool.h"
+#include "Animation/AnimSequence.h"
+#include "HAL/PlatformTime.h"
 #include "Rendering/SkeletalMeshRenderData.h"
 #include "Misc/ConfigCacheIni.h"
 #include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
 #include "ProfilingDebugging/ScopedTimers.h"
 
 UPBDSoftBodyComponent::UPBDSoftBodyComponent()
@@ -18,10 +28,56 @@ UPBDSoftBodyComponent::UPBDSoftBodyComponent()
     bHasLoggedBlending = false;
     bHasLoggedBlendingVerbose = false;
     bHasLoggedInvalidObjects = false;
+    bResyncToAnimation = false;
+    OffscreenFrameCounter = 0;
+
+    bWeldVertices = true;
+    WeldTolerance = 0.01f;
+    SkinningMode = ESoftBodySkinningMode::Linear;
+    bApplyMorphTargets = true;
+
+    bRecomputeTangents = true;
+    bRecomputeTangentsDirtyOnly = true;
+
+    bEnableSolver = false;
+    SolverIterations = 9;
+    StretchCompliance = 0.0f;
+    GoalCompliance = 1.0e-4f;
+    SolverDamping = 0.98f;
+    SolverMode = ESoftBodySolverMode::GaussSeidel;
+    JacobiRelaxation = 1.5f;
+    ChebyshevRho = 0.9f;
+    bEnableTethers = true;
+    TetherRadius = 2.0f;
+    bAdaptiveIterations = true;
+    MinSolverIterations = 1;
+    MaxSolverIterations = 20;
+    ResidualTolerance = 0.01f;
+    bHierarchicalSolver = true;
+    SolverLevels = 3;
+    ClustersPerSuperCluster = 4;
+
+    bPlayDeltaCache = false;
+    DeltaCacheFramesPerChunk = 64;
+    DeltaCacheTime = 0.0f;
+
+    bUseInstancePool = true;
+
+    bEnableClusterSleeping = true;
+    SleepThreshold = 0.05f;
+    SleepFrameCount = 30;
+    bEnableVisibilityCulling = true;
+    OffscreenMode = ESoftBodyOffscreenMode::ReducedRate;
+    OffscreenUpdateInterval = 4;
+    OffscreenTimeout = 0.2f;
 
     ClusterManager = nullptr;
     VertexBufferUpdater = nullptr;
     AnimationBlender = nullptr;
+    DeltaCache = nullptr;
+    Solver = nullptr;
+    DebugDrawComponent = nullptr;
+    BoneRecorder = nullptr;
 
     PrimaryComponentTick.bCanEverTick = true;
 
@@ -74,8 +130,100 @@ void UPBDSoftBodyComponent::InitializeConfig()
         }
     }
 
+    // Welding, tangent and culling settings are optional; missing keys keep the constructor defaults
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("WeldVertices"), bWeldVertices, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("WeldTolerance"), WeldTolerance, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("ApplyMorphTargets"), bApplyMorphTargets, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("RecomputeTangents"), bRecomputeTangents, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("RecomputeTangentsDirtyOnly"), bRecomputeTangentsDirtyOnly, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("EnableSolver"), bEnableSolver, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("SolverIterations"), SolverIterations, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("StretchCompliance"), StretchCompliance, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("GoalCompliance"), GoalCompliance, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("SolverDamping"), SolverDamping, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("JacobiRelaxation"), JacobiRelaxation, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("ChebyshevRho"), ChebyshevRho, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("EnableTethers"), bEnableTethers, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("TetherRadius"), TetherRadius, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("AdaptiveIterations"), bAdaptiveIterations, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("MinSolverIterations"), MinSolverIterations, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("MaxSolverIterations"), MaxSolverIterations, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("ResidualTolerance"), ResidualTolerance, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("HierarchicalSolver"), bHierarchicalSolver, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("SolverLevels"), SolverLevels, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("ClustersPerSuperCluster"), ClustersPerSuperCluster, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("EnableClusterSleeping"), bEnableClusterSleeping, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("SleepThreshold"), SleepThreshold, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("SleepFrameCount"), SleepFrameCount, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("EnableVisibilityCulling"), bEnableVisibilityCulling, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("OffscreenUpdateInterval"), OffscreenUpdateInterval, NormalizedConfigPath);
+    GConfig->GetFloat(TEXT("PBDSoftBody"), TEXT("OffscreenTimeout"), OffscreenTimeout, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("PlayDeltaCache"), bPlayDeltaCache, NormalizedConfigPath);
+    GConfig->GetString(TEXT("PBDSoftBody"), TEXT("DeltaCachePath"), DeltaCachePath, NormalizedConfigPath);
+    GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("DeltaCacheFramesPerChunk"), DeltaCacheFramesPerChunk, NormalizedConfigPath);
+    GConfig->GetBool(TEXT("PBDSoftBody"), TEXT("UseInstancePool"), bUseInstancePool, NormalizedConfigPath);
+
+    FString OffscreenModeName;
+    if (GConfig->GetString(TEXT("PBDSoftBody"), TEXT("OffscreenMode"), OffscreenModeName, NormalizedConfigPath))
+    {
+        const int64 ModeValue = StaticEnum<ESoftBodyOffscreenMode>()->GetValueByNameString(OffscreenModeName);
+        if (ModeValue != INDEX_NONE)
+        {
+            OffscreenMode = static_cast<ESoftBodyOffscreenMode>(ModeValue);
+        }
+        else if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Unknown OffscreenMode '%s' in %s. Using default."), *OffscreenModeName, *NormalizedConfigPath);
+        }
+    }
+
+    FString SkinningModeName;
+    if (GConfig->GetString(TEXT("PBDSoftBody"), TEXT("SkinningMode"), SkinningModeName, NormalizedConfigPath))
+    {
+        const int64 ModeValue = StaticEnum<ESoftBodySkinningMode>()->GetValueByNameString(SkinningModeName);
+        if (ModeValue != INDEX_NONE)
+        {
+            SkinningMode = static_cast<ESoftBodySkinningMode>(ModeValue);
+        }
+        else if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Unknown SkinningMode '%s' in %s. Using default."), *SkinningModeName, *NormalizedConfigPath);
+        }
+    }
+
+    FString SolverModeName;
+    if (GConfig->GetString(TEXT("PBDSoftBody"), TEXT("SolverMode"), SolverModeName, NormalizedConfigPath))
+    {
+        const int64 ModeValue = StaticEnum<ESoftBodySolverMode>()->GetValueByNameString(SolverModeName);
+        if (ModeValue != INDEX_NONE)
+        {
+            SolverMode = static_cast<ESoftBodySolverMode>(ModeValue);
+        }
+        else if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Unknown SolverMode '%s' in %s. Using default."), *SolverModeName, *NormalizedConfigPath);
+        }
+    }
+
     SoftBodyBlendWeight = FMath::Clamp(SoftBodyBlendWeight, 0.0f, 1.0f);
     NumClusters = FMath::Max(NumClusters, 1);
+    WeldTolerance = FMath::Max(WeldTolerance, 0.0f);
+    SleepThreshold = FMath::Max(SleepThreshold, 0.0f);
+    SleepFrameCount = FMath::Max(SleepFrameCount, 1);
+    OffscreenUpdateInterval = FMath::Max(OffscreenUpdateInterval, 1);
+    DeltaCacheFramesPerChunk = FMath::Max(DeltaCacheFramesPerChunk, 1);
+    SolverIterations = FMath::Max(SolverIterations, 1);
+    StretchCompliance = FMath::Max(StretchCompliance, 0.0f);
+    GoalCompliance = FMath::Max(GoalCompliance, 0.0f);
+    SolverDamping = FMath::Clamp(SolverDamping, 0.0f, 1.0f);
+    JacobiRelaxation = FMath::Clamp(JacobiRelaxation, 0.1f, 2.0f);
+    ChebyshevRho = FMath::Clamp(ChebyshevRho, 0.0f, 0.9999f);
+    TetherRadius = FMath::Max(TetherRadius, 0.0f);
+    MinSolverIterations = FMath::Max(MinSolverIterations, 1);
+    MaxSolverIterations = FMath::Max(MaxSolverIterations, MinSolverIterations);
+    ResidualTolerance = FMath::Max(ResidualTolerance, 0.0f);
+    SolverLevels = FMath::Clamp(SolverLevels, 2, 3);
+    ClustersPerSuperCluster = FMath::Max(ClustersPerSuperCluster, 2);
 
     if (bEnableDebugLogging)
     {
@@ -85,9 +233,63 @@ void UPBDSoftBodyComponent::InitializeConfig()
 
 void UPBDSoftBodyComponent::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(PBDSoftBody);
     Super::BeginPlay();
     InitializeConfig();
 
+    // A pooled instance brings its helpers and built data along
+    USoftBodyInstancePool* Pool = bUseInstancePool ? USoftBodyInstancePool::Get(GetWorld()) : nullptr;
+    if (Pool && Pool->Acquire(this))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: BeginPlay called for %s. Reusing a pooled instance (%d particles, %d clusters)."),
+                *GetOwner()->GetName(), SimulatedPositions.Num(), Clusters.Num());
+        }
+        return;
+    }
+
+    CreateHelpers();
+
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: BeginPlay called for %s."), *GetOwner()->GetName());
+    }
+
+    if (!InitializeSimulationData())
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Initialization failed in BeginPlay for %s. Retrying in Tick."), *GetOwner()->GetName());
+        }
+    }
+}
+
+void UPBDSoftBodyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Only actors leaving a world that keeps running are worth recycling
+    if (bUseInstancePool && (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld))
+    {
+        if (USoftBodyInstancePool* Pool = USoftBodyInstancePool::Get(GetWorld()))
+        {
+            const bool bReleased = Pool->Release(this);
+            if (bEnableDebugLogging && bReleased)
+            {
+                UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Returned simulation instance of %s to the pool."), *GetNameSafe(GetOwner()));
+            }
+        }
+    }
+    if (DebugDrawComponent)
+    {
+        DebugDrawComponent->DestroyComponent();
+        DebugDrawComponent = nullptr;
+    }
+    StopBoneRecording();
+    Super::EndPlay(EndPlayReason);
+}
+
+void UPBDSoftBodyComponent::CreateHelpers()
+{
     if (!ClusterManager)
     {
         ClusterManager = NewObject<UClusterManager>(this, NAME_None, RF_NoFlags, nullptr, true);
@@ -112,23 +314,144 @@ void UPBDSoftBodyComponent::BeginPlay()
             UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: AnimationBlender created: %s"), AnimationBlender ? TEXT("Success") : TEXT("Failed"));
         }
     }
+}
 
-    if (bEnableDebugLogging)
+void UPBDSoftBodyComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    FSoftBodyMemoryUsage Usage;
+    GetMemoryUsage(Usage);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Usage.GetTotal());
+}
+
+void UPBDSoftBodyComponent::GetMemoryUsage(FSoftBodyMemoryUsage& OutUsage) const
+{
+    OutUsage = FSoftBodyMemoryUsage();
+    OutUsage.SimulationBytes = SimulatedPositions.GetAllocatedSize() + Velocities.GetAllocatedSize() + AnimatedPositions.GetAllocatedSize()
+        + Clusters.GetAllocatedSize() + LastSkinnedBoneTransforms.GetAllocatedSize();
+    OutUsage.MeshDataBytes = ParticleLayout.ParticleToRenderVertex.GetAllocatedSize() + ParticleLayout.RenderToParticle.GetAllocatedSize()
+        + SectionRanges.GetAllocatedSize();
+    for (const FSoftBodyCluster& Cluster : Clusters)
     {
-        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: BeginPlay called for %s."), *GetOwner()->GetName());
+        OutUsage.MeshDataBytes += Cluster.VertexIndices.GetAllocatedSize() + Cluster.VertexOffsets.GetAllocatedSize();
+    }
+    if (IsValid(Solver))
+    {
+        const SIZE_T TopologyBytes = Solver->GetTopologyAllocatedSize();
+        OutUsage.MeshDataBytes += TopologyBytes;
+        OutUsage.SimulationBytes += Solver->GetAllocatedSize() - TopologyBytes;
+    }
+    if (IsValid(VertexBufferUpdater))
+    {
+        const SIZE_T TopologyBytes = VertexBufferUpdater->GetTopologyAllocatedSize();
+        OutUsage.MeshDataBytes += TopologyBytes;
+        OutUsage.UploadBytes += VertexBufferUpdater->GetAllocatedSize() - TopologyBytes;
+    }
+    if (IsValid(AnimationBlender))
+    {
+        OutUsage.ScratchBytes += AnimationBlender->GetAllocatedSize();
+    }
+    if (IsValid(DeltaCache))
+    {
+        OutUsage.CacheBytes += DeltaCache->GetAllocatedSize() + DeltaCache->GetMappedSize();
+    }
+}
+
+uint32 UPBDSoftBodyComponent::GetPoolSettingsHash() const
+{
+    uint32 Hash = GetTypeHash(SectionModes.Num());
+    for (const ESoftBodySectionMode Mode : SectionModes)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Mode));
     }
+    Hash = HashCombine(Hash, GetTypeHash(bWeldVertices));
+    Hash = HashCombine(Hash, GetTypeHash(WeldTolerance));
+    Hash = HashCombine(Hash, GetTypeHash(bRecomputeTangents));
+    Hash = HashCombine(Hash, GetTypeHash(bEnableSolver));
+    Hash = HashCombine(Hash, GetTypeHash(bHierarchicalSolver));
+    Hash = HashCombine(Hash, GetTypeHash(SolverLevels));
+    Hash = HashCombine(Hash, GetTypeHash(ClustersPerSuperCluster));
+    return Hash;
+}
 
-    if (!InitializeSimulationData())
+void UPBDSoftBodyComponent::AdoptPooledInstance(FSoftBodyPooledInstance& Instance)
+{
+    ClusterManager = Instance.ClusterManager;
+    VertexBufferUpdater = Instance.VertexBufferUpdater;
+    AnimationBlender = Instance.AnimationBlender;
+    Solver = Instance.Solver;
+
+    // The pool outered the helpers to itself while they were parked; take them back so they live and die with this
+    // component (and are found under it), and the pool re-outers them again on release
+    UObject* Helpers[] = { ClusterManager, VertexBufferUpdater, AnimationBlender, Solver };
+    for (UObject* Helper : Helpers)
     {
-        if (bEnableDebugLogging)
+        if (Helper && Helper->GetOuter() != this)
         {
-            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Initialization failed in BeginPlay for %s. Retrying in Tick."), *GetOwner()->GetName());
+            Helper->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
         }
     }
+
+    NumClusters = Instance.NumClusters;
+    Clusters = MoveTemp(Instance.Clusters);
+    SectionRanges = MoveTemp(Instance.SectionRanges);
+    ParticleLayout = MoveTemp(Instance.ParticleLayout);
+    SimulatedPositions = MoveTemp(Instance.SimulatedPositions);
+    Velocities = MoveTemp(Instance.Velocities);
+    AnimatedPositions = MoveTemp(Instance.AnimatedPositions);
+
+    // Drop whatever motion the previous owner left behind and snap to this instance's pose
+    FMemory::Memzero(Velocities.GetData(), Velocities.Num() * sizeof(FVector));
+    for (FSoftBodyCluster& Cluster : Clusters)
+    {
+        Cluster.WakeUp();
+        Cluster.CentroidVelocity = FVector::ZeroVector;
+        Cluster.bUpdatedThisFrame = false;
+    }
+    LastSkinnedBoneTransforms.Reset();
+    bHasLoggedVertexCount = false;
+    bHasLoggedBlending = false;
+    bResyncToAnimation = true;
+    AnimationBlender->UpdateBlendedPositions(this);
+    if (IsValid(Solver))
+    {
+        Solver->ResetState(this);
+    }
+
+    if (bPlayDeltaCache)
+    {
+        OpenDeltaCache();
+    }
+}
+
+void UPBDSoftBodyComponent::MoveToPooledInstance(FSoftBodyPooledInstance& OutInstance)
+{
+    OutInstance.ClusterManager = ClusterManager;
+    OutInstance.VertexBufferUpdater = VertexBufferUpdater;
+    OutInstance.AnimationBlender = AnimationBlender;
+    OutInstance.Solver = Solver;
+    OutInstance.NumClusters = NumClusters;
+    OutInstance.Clusters = MoveTemp(Clusters);
+    OutInstance.SectionRanges = MoveTemp(SectionRanges);
+    OutInstance.ParticleLayout = MoveTemp(ParticleLayout);
+    OutInstance.SimulatedPositions = MoveTemp(SimulatedPositions);
+    OutInstance.Velocities = MoveTemp(Velocities);
+    OutInstance.AnimatedPositions = MoveTemp(AnimatedPositions);
+
+    ClusterManager = nullptr;
+    VertexBufferUpdater = nullptr;
+    AnimationBlender = nullptr;
+    Solver = nullptr;
+    if (IsValid(DeltaCache))
+    {
+        DeltaCache->Close();
+    }
 }
 
 void UPBDSoftBodyComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(PBDSoftBody);
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
     static int32 TickCount = 0;
@@ -178,23 +501,395 @@ void UPBDSoftBodyComponent::TickComponent(float DeltaTime, ELevelTick TickType,
     }
 
     bHasLoggedInvalidObjects = false;
-    AnimationBlender->UpdateBlendedPositions(this);
-    VertexBufferUpdater->ApplyPositions(this);
+
+    // Every tick is recorded, including frozen and reduced-rate ones, so a replay sees the same clock and motion
+    if (BoneRecorder)
+    {
+        BoneRecorder->AddFrame(DeltaTime, GetSkinningBoneTransforms());
+    }
+
+    // The cache clock keeps running through culled frames so playback stays in step once visible again
+    DeltaCacheTime += DeltaTime;
+
+    const ESoftBodyUpdateTier UpdateTier = ComputeUpdateTier();
+    SimulationStats.ResetFrameCounters();
+    SimulationStats.UpdateTier = UpdateTier;
+
+    // Before the tier early-outs so frozen and culled actors still show; draws the previous frame's result
+    UpdateDebugDraw();
+
+    if (UpdateTier == ESoftBodyUpdateTier::Frozen)
+    {
+        return;
+    }
+    if (UpdateTier == ESoftBodyUpdateTier::AnimationOnly)
+    {
+        // The engine keeps animating the mesh; the sim snaps back to that pose once visible again
+        bResyncToAnimation = true;
+        return;
+    }
+    if (UpdateTier == ESoftBodyUpdateTier::ReducedRate)
+    {
+        if (++OffscreenFrameCounter % OffscreenUpdateInterval != 0)
+        {
+            return;
+        }
+    }
+    else
+    {
+        OffscreenFrameCounter = 0;
+    }
+
+    const double UpdateStartTime = FPlatformTime::Seconds();
+    if (IsValid(DeltaCache) && DeltaCache->IsOpen())
+    {
+        if (DeltaCache->DecodeFrame(DeltaCache->GetFrameAtTime(DeltaCacheTime), SimulatedPositions))
+        {
+            for (FSoftBodyCluster& Cluster : Clusters)
+            {
+                Cluster.bUpdatedThisFrame = true;
+            }
+            SimulationStats.SimulatedVertices = SimulatedPositions.Num();
+            SimulationStats.bPlayedFromCache = true;
+        }
+    }
+    else
+    {
+        AnimationBlender->UpdateBlendedPositions(this);
+    }
+    const double SolveStartTime = FPlatformTime::Seconds();
+    SimulationStats.UpdateTimeMs = static_cast<float>((SolveStartTime - UpdateStartTime) * 1000.0);
+
+    // Cached frames already contain the solved result
+    if (bEnableSolver && IsValid(Solver) && !SimulationStats.bPlayedFromCache && SimulationStats.SimulatedVertices > 0)
+    {
+        Solver->Step(this, UpdateTier == ESoftBodyUpdateTier::ReducedRate ? DeltaTime * OffscreenUpdateInterval : DeltaTime);
+    }
+    const double UploadStartTime = FPlatformTime::Seconds();
+    SimulationStats.SolveTimeMs = static_cast<float>((UploadStartTime - SolveStartTime) * 1000.0);
+
+    if (SimulationStats.SimulatedVertices > 0)
+    {
+        VertexBufferUpdater->ApplyPositions(this);
+        SimulationStats.UploadTimeMs = static_cast<float>((FPlatformTime::Seconds() - UploadStartTime) * 1000.0);
+    }
 
     if (bVerboseDebugLogging && (TickCount % 60 == 0)) // Throttle completion log
     {
-        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Tick completed for %s with DeltaTime: %.3f"), *GetOwner()->GetName(), DeltaTime);
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Tick completed for %s with DeltaTime: %.3f - Simulated %d/%d vertices%s, %d awake / %d sleeping clusters, uploaded %d vertices (update %.3f ms, solve %.3f ms in %d iterations with residual %.4f, upload %.3f ms)."),
+            *GetOwner()->GetName(), DeltaTime, SimulationStats.SimulatedVertices, SimulatedPositions.Num(),
+            SimulationStats.bPlayedFromCache ? TEXT(" from cache") : TEXT(""),
+            SimulationStats.AwakeClusters, SimulationStats.SleepingClusters, SimulationStats.UploadedVertices,
+            SimulationStats.UpdateTimeMs, SimulationStats.SolveTimeMs, SimulationStats.SolverIterationsUsed, SimulationStats.SolverResidual,
+            SimulationStats.UploadTimeMs);
+    }
+}
+
+bool UPBDSoftBodyComponent::StartBoneRecording(const FString& FilePath)
+{
+    StopBoneRecording();
+
+    const USkeletalMesh* Mesh = GetSkeletalMeshAsset();
+    const int32 NumBones = GetSkinningBoneTransforms().Num();
+    if (!Mesh || NumBones == 0)
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Cannot record bone transforms of %s - no mesh or pose."), *GetNameSafe(GetOwner()));
+        }
+        return false;
+    }
+
+    BoneRecorder = NewObject<USoftBodyBoneRecorder>(this, NAME_None, RF_Transient);
+    const FString FullPath = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectDir(), FilePath) : FilePath;
+    if (!BoneRecorder->Start(FullPath, Mesh->GetPathName(), NumBones))
+    {
+        BoneRecorder = nullptr;
+        return false;
+    }
+    return true;
+}
+
+int32 UPBDSoftBodyComponent::StopBoneRecording()
+{
+    if (!BoneRecorder)
+    {
+        return 0;
+    }
+    const int32 NumFrames = BoneRecorder->Stop();
+    BoneRecorder = nullptr;
+    return NumFrames;
+}
+
+void UPBDSoftBodyComponent::SetBoneTransformOverride(const TArray<FTransform>& Transforms)
+{
+    BoneTransformOverride = Transforms;
+}
+
+void UPBDSoftBodyComponent::ClearBoneTransformOverride()
+{
+    BoneTransformOverride.Empty();
+}
+
+const TArray<FTransform>& UPBDSoftBodyComponent::GetSkinningBoneTransforms() const
+{
+    return HasBoneTransformOverride() ? BoneTransformOverride : GetComponentSpaceTransforms();
+}
+
+void UPBDSoftBodyComponent::UpdateDebugDraw()
+{
+    const ESoftBodyDebugDrawMode Mode = USoftBodyDebugDrawComponent::GetRequestedMode();
+    if (Mode == ESoftBodyDebugDrawMode::None)
+    {
+        if (DebugDrawComponent)
+        {
+            DebugDrawComponent->DestroyComponent();
+            DebugDrawComponent = nullptr;
+        }
+        return;
+    }
+
+    if (!IsValid(DebugDrawComponent))
+    {
+        DebugDrawComponent = NewObject<USoftBodyDebugDrawComponent>(GetOwner(), NAME_None, RF_Transient);
+        DebugDrawComponent->SetupAttachment(this);
+        DebugDrawComponent->RegisterComponent();
+    }
+    DebugDrawComponent->UpdateFromSimulation(this, Solver, Mode);
+}
+
+void UPBDSoftBodyComponent::GetDeltaCacheLayout(TArray<FSoftBodyDeltaCacheClusterRange>& OutRanges, TArray<FVector3f>& OutRestOffsets) const
+{
+    OutRanges.Reset();
+    OutRestOffsets.SetNumZeroed(ParticleLayout.GetNumParticles());
+    for (const FSoftBodyCluster& Cluster : Clusters)
+    {
+        OutRanges.Add({ Cluster.ParticleStart, Cluster.ParticleCount });
+        for (int32 i = 0; i < Cluster.ParticleCount; i++)
+        {
+            OutRestOffsets[Cluster.ParticleStart + i] = FVector3f(Cluster.VertexOffsets[i]);
+        }
+    }
+    for (const FSoftBodySectionRange& Range : SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Rigid && Range.NumParticles > 0)
+        {
+            OutRanges.Add({ Range.FirstParticle, Range.NumParticles });
+        }
+    }
+}
+
+bool UPBDSoftBodyComponent::BakeDeltaCache(UAnimSequence* Sequence, const FString& FilePath, float SampleRate)
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    if (!Sequence || SampleRate <= 0.0f || FilePath.IsEmpty())
+    {
+        return false;
+    }
+    if ((SimulatedPositions.Num() == 0 && !InitializeSimulationData()) || !IsValid(AnimationBlender))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Cannot bake %s - simulation data is not initialized."), *GetNameSafe(GetOwner()));
+        }
+        return false;
+    }
+
+    TArray<FSoftBodyDeltaCacheClusterRange> CacheRanges;
+    TArray<FVector3f> RestOffsets;
+    GetDeltaCacheLayout(CacheRanges, RestOffsets);
+
+    FVertexDeltaCacheWriter Writer;
+    if (!Writer.Open(FilePath, CacheRanges, RestOffsets, SampleRate, DeltaCacheFramesPerChunk))
+    {
+        return false;
+    }
+
+    // Sample the sequence frame by frame and run the same update the tick would, carrying state across frames
+    const int32 NumFrames = FMath::FloorToInt(Sequence->GetPlayLength() * SampleRate) + 1;
+    const double BakeStartTime = FPlatformTime::Seconds();
+    // Playback skips the solver (cached frames are final), so the bake has to run it
+    const bool bRunSolver = bEnableSolver && IsValid(Solver);
+    PlayAnimation(Sequence, false);
+    bResyncToAnimation = true;
+    for (FVector& Velocity : Velocities)
+    {
+        Velocity = FVector::ZeroVector;
+    }
+    for (int32 Frame = 0; Frame < NumFrames; Frame++)
+    {
+        SetPosition(Frame / SampleRate, false);
+        TickAnimation(0.0f, false);
+        RefreshBoneTransforms();
+        SimulationStats.ResetFrameCounters();
+        AnimationBlender->UpdateBlendedPositions(this);
+        if (bRunSolver)
+        {
+            // Reset once the first frame has snapped to the clip, so the jump from the previous pose is not read as velocity
+            if (Frame == 0)
+            {
+                Solver->ResetState(this);
+            }
+            if (SimulationStats.SimulatedVertices > 0)
+            {
+                Solver->Step(this, 1.0f / SampleRate);
+            }
+        }
+        if (!Writer.AddFrame(SimulatedPositions))
+        {
+            Writer.Close();
+            return false;
+        }
+    }
+
+    const bool bSuccess = Writer.Close();
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Baked %d frames of %s (%d particles) to %s in %.1f ms - %lld bytes (%.1f bytes/particle/frame)%s."),
+            NumFrames, *Sequence->GetName(), SimulatedPositions.Num(), *FilePath, (FPlatformTime::Seconds() - BakeStartTime) * 1000.0,
+            Writer.GetBytesWritten(), static_cast<double>(Writer.GetBytesWritten()) / FMath::Max(NumFrames * SimulatedPositions.Num(), 1),
+            bSuccess ? TEXT("") : TEXT(" [FAILED]"));
+    }
+    return bSuccess;
+}
+
+bool UPBDSoftBodyComponent::OpenDeltaCache()
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    if (!IsValid(DeltaCache))
+    {
+        DeltaCache = NewObject<UVertexDeltaCache>(this);
+    }
+
+    const FString FullPath = FPaths::IsRelative(DeltaCachePath) ? FPaths::Combine(FPaths::ProjectDir(), DeltaCachePath) : DeltaCachePath;
+    if (DeltaCachePath.IsEmpty() || !DeltaCache->Open(FullPath))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Could not open delta cache '%s' for %s. Simulating instead."), *FullPath, *GetNameSafe(GetOwner()));
+        }
+        return false;
+    }
+
+    TArray<FSoftBodyDeltaCacheClusterRange> CacheRanges;
+    TArray<FVector3f> RestOffsets;
+    GetDeltaCacheLayout(CacheRanges, RestOffsets);
+    if (!DeltaCache->IsCompatible(SimulatedPositions.Num(), CacheRanges))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Delta cache '%s' was baked with a different particle layout than %s. Simulating instead."),
+                *FullPath, *GetNameSafe(GetOwner()));
+        }
+        DeltaCache->Close();
+        return false;
+    }
+
+    DeltaCacheTime = 0.0f;
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Playing %d cached frames from '%s' for %s."), DeltaCache->GetNumFrames(), *FullPath, *GetNameSafe(GetOwner()));
+    }
+    return true;
+}
+
+bool UPBDSoftBodyComponent::SaveSnapshot(TArray<uint8>& OutData) const
+{
+    return FSoftBodySnapshot::Save(*this, OutData);
+}
+
+bool UPBDSoftBodyComponent::RestoreSnapshot(const TArray<uint8>& Data)
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    if (SimulatedPositions.Num() == 0 && !InitializeSimulationData())
+    {
+        return false;
+    }
+
+    const double RestoreStartTime = FPlatformTime::Seconds();
+    if (!FSoftBodySnapshot::Restore(*this, Data))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Snapshot (%d bytes) does not match the particle layout of %s."), Data.Num(), *GetNameSafe(GetOwner()));
+        }
+        return false;
+    }
+
+    // Continue from the restored state rather than snapping to the pose, and skin again on the next tick
+    bResyncToAnimation = false;
+    LastSkinnedBoneTransforms.Reset();
+    if (IsValid(Solver))
+    {
+        Solver->ResetState(this);
+    }
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Restored %d particles for %s in %.3f ms."),
+            SimulatedPositions.Num(), *GetNameSafe(GetOwner()), (FPlatformTime::Seconds() - RestoreStartTime) * 1000.0);
+    }
+
+    // Sleeping clusters would not be rewritten next tick, so push the restored positions now
+    if (IsValid(VertexBufferUpdater))
+    {
+        VertexBufferUpdater->ApplyPositions(this);
+    }
+    return true;
+}
+
+bool UPBDSoftBodyComponent::SaveSnapshotToFile(const FString& FilePath) const
+{
+    TArray<uint8> Data;
+    return SaveSnapshot(Data) && FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+bool UPBDSoftBodyComponent::RestoreSnapshotFromFile(const FString& FilePath)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+    {
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: Failed to read snapshot %s."), *FilePath);
+        }
+        return false;
+    }
+    return RestoreSnapshot(Data);
+}
+
+ESoftBodySectionMode UPBDSoftBodyComponent::GetSectionMode(int32 SectionIndex) const
+{
+    return SectionModes.IsValidIndex(SectionIndex) ? SectionModes[SectionIndex] : ESoftBodySectionMode::Simulated;
+}
+
+ESoftBodyUpdateTier UPBDSoftBodyComponent::ComputeUpdateTier() const
+{
+    if (!bEnableVisibilityCulling || WasRecentlyRendered(OffscreenTimeout))
+    {
+        return ESoftBodyUpdateTier::Full;
+    }
+
+    switch (OffscreenMode)
+    {
+    case ESoftBodyOffscreenMode::Freeze:
+        return ESoftBodyUpdateTier::Frozen;
+    case ESoftBodyOffscreenMode::AnimationOnly:
+        return ESoftBodyUpdateTier::AnimationOnly;
+    case ESoftBodyOffscreenMode::ReducedRate:
+    default:
+        return ESoftBodyUpdateTier::ReducedRate;
     }
 }
 
 bool UPBDSoftBodyComponent::InitializeSimulationData()
 {
+    LLM_SCOPE_BYTAG(PBDSoftBody);
     USkeletalMesh* Mesh = GetSkeletalMeshAsset();
     if (!IsValid(Mesh))
     {
         if (bEnableDebugLogging && IsValid(GetOwner()))
         {
-            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: No valid SkeletalMesh assigned to %s."), *GetOwner()->GetName());
+            UE_LOG(LogTemp, Warning, TEXT("PBDSoftBodyComponent: No valid SkeletalMesh assigned to %s."), *GetNameSafe(GetOwner()));
         }
         return false;
     }
@@ -209,7 +904,7 @@ bool UPBDSoftBodyComponent::InitializeSimulationData()
         return false;
     }
 
-    const FSkeletalMeshLODRenderData* LODRenderData = &RenderData->LODRenderData[0];
+    const FSkeletalMeshLODRenderData* LODRenderData = &RenderData->LODRenderData[SimulationLODIndex];
     int32 VertexCount = LODRenderData->GetNumVertices();
     if (VertexCount <= 0)
     {
@@ -220,53 +915,67 @@ bool UPBDSoftBodyComponent::InitializeSimulationData()
         return false;
     }
 
-    const int32 MinClusters = 1;
-    const int32 MaxClusters = 100;
-    NumClusters = FMath::Clamp(VertexCount / 1000, MinClusters, MaxClusters);
-    if (bEnableDebugLogging)
-    {
-        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Initializing simulation data for %s with %d vertices. Calculated NumClusters: %d."),
-            *Mesh->GetName(), VertexCount, NumClusters);
-    }
-
     Velocities.Reset();
     SimulatedPositions.Reset();
     Clusters.Reset();
+    ParticleLayout.Reset();
+    AnimatedPositions.Reset();
+    LastSkinnedBoneTransforms.Reset();
+    bResyncToAnimation = false;
 
-    if (!IsValid(AnimationBlender))
+    if (!IsValid(AnimationBlender) || !IsValid(ClusterManager))
     {
         if (bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: AnimationBlender is invalid during initialization for %s."), *Mesh->GetName());
+            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: %s is invalid during initialization for %s."),
+                IsValid(AnimationBlender) ? TEXT("ClusterManager") : TEXT("AnimationBlender"), *Mesh->GetName());
         }
         return false;
     }
 
-    TArray<FVector> InitialPositions = AnimationBlender->GetVertexPositions(this);
-    if (InitialPositions.Num() != VertexCount)
+    ClusterManager->BuildSectionRanges(this, *LODRenderData);
+
+    FSoftBodyWeldMap WeldMap;
+    double WeldTimeMs = 0.0;
     {
-        if (bEnableDebugLogging)
+        FScopedDurationTimer WeldTimer(WeldTimeMs);
+        ClusterManager->BuildWeldMap(this, *LODRenderData, WeldMap);
+    }
+
+    int32 SimulatedVertexCount = 0;
+    int32 SimulatedParticleCount = 0;
+    for (int32 RangeIdx = 0; RangeIdx < SectionRanges.Num(); RangeIdx++)
+    {
+        if (SectionRanges[RangeIdx].Mode == ESoftBodySectionMode::Simulated)
         {
-            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: Vertex position retrieval failed for %s. Expected %d, got %d."),
-                *Mesh->GetName(), VertexCount, InitialPositions.Num());
+            SimulatedVertexCount += SectionRanges[RangeIdx].NumVertices;
+            SimulatedParticleCount += WeldMap.SectionOffsets[RangeIdx + 1] - WeldMap.SectionOffsets[RangeIdx];
         }
-        return false;
+    }
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Welded render vertices of %s into %d particles in %.3f ms (%d -> %d in simulated sections)."),
+            *Mesh->GetName(), WeldMap.UniqueVertices.Num(), WeldTimeMs, SimulatedVertexCount, SimulatedParticleCount);
     }
 
-    Velocities.SetNum(VertexCount, EAllowShrinking::No);
-    SimulatedPositions.SetNum(VertexCount, EAllowShrinking::No);
-
-    for (int32 i = 0; i < VertexCount; i++)
+    const int32 MinClusters = 1;
+    const int32 MaxClusters = 100;
+    NumClusters = FMath::Clamp(SimulatedParticleCount / 1000, MinClusters, MaxClusters);
+    if (bEnableDebugLogging)
     {
-        Velocities[i] = FVector::ZeroVector;
-        SimulatedPositions[i] = InitialPositions[i];
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Initializing simulation data for %s with %d vertices (%d particles in simulated sections). Calculated NumClusters: %d."),
+            *Mesh->GetName(), VertexCount, SimulatedParticleCount, NumClusters);
     }
 
-    if (!IsValid(ClusterManager))
+    // No particle layout yet, so these come back in render order
+    TArray<FVector> InitialPositions;
+    AnimationBlender->GetVertexPositions(this, InitialPositions);
+    if (InitialPositions.Num() != VertexCount)
     {
         if (bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: ClusterManager is invalid during initialization for %s."), *Mesh->GetName());
+            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: Vertex position retrieval failed for %s. Expected %d, got %d."),
+                *Mesh->GetName(), VertexCount, InitialPositions.Num());
         }
         return false;
     }
@@ -274,7 +983,7 @@ bool UPBDSoftBodyComponent::InitializeSimulationData()
     double ClusteringTimeMs = 0.0;
     {
         FScopedDurationTimer ClusteringTimer(ClusteringTimeMs);
-        ClusterManager->GenerateClusters(this, InitialPositions);
+        ClusterManager->GenerateClusters(this, InitialPositions, WeldMap);
     }
     if (bEnableDebugLogging)
     {
@@ -291,11 +1000,66 @@ bool UPBDSoftBodyComponent::InitializeSimulationData()
     {
         if (bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: Cluster generation failed for %s."), *Mesh->GetName());
+            UE_LOG(LogTemp, Error, TEXT("PBDSoftBodyComponent: Cluster generation failed for %s. At least one section must be simulated."), *Mesh->GetName());
         }
         return false;
     }
 
+    double LayoutTimeMs = 0.0;
+    {
+        FScopedDurationTimer LayoutTimer(LayoutTimeMs);
+        ClusterManager->BuildParticleLayout(this, WeldMap);
+    }
+    const int32 NumParticles = ParticleLayout.GetNumParticles();
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Particle layout for %s built in %.3f ms (%d particles)."),
+            *Mesh->GetName(), LayoutTimeMs, NumParticles);
+    }
+
+    if (IsValid(VertexBufferUpdater))
+    {
+        double AdjacencyTimeMs = 0.0;
+        {
+            FScopedDurationTimer AdjacencyTimer(AdjacencyTimeMs);
+            VertexBufferUpdater->BuildTangentData(this, *LODRenderData);
+        }
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Vertex-triangle adjacency for %s built in %.3f ms."), *Mesh->GetName(), AdjacencyTimeMs);
+        }
+    }
+
+    Velocities.SetNum(NumParticles, EAllowShrinking::No);
+    SimulatedPositions.SetNum(NumParticles, EAllowShrinking::No);
+    AnimatedPositions.Reserve(NumParticles);
+
+    for (int32 i = 0; i < NumParticles; i++)
+    {
+        Velocities[i] = FVector::ZeroVector;
+        SimulatedPositions[i] = InitialPositions[ParticleLayout.ParticleToRenderVertex[i]];
+    }
+
+    if (bEnableSolver)
+    {
+        if (!IsValid(Solver))
+        {
+            Solver = NewObject<USoftBodySolver>(this);
+        }
+        const double SolverBuildStartTime = FPlatformTime::Seconds();
+        Solver->Build(this, *LODRenderData, ClusterManager);
+        if (bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Solver for %s built in %.3f ms (%d constraints, %d colors)."),
+                *Mesh->GetName(), (FPlatformTime::Seconds() - SolverBuildStartTime) * 1000.0, Solver->GetNumConstraints(), Solver->GetNumColors());
+        }
+    }
+
+    if (bPlayDeltaCache)
+    {
+        OpenDeltaCache();
+    }
+
     if (bEnableDebugLogging && bVerboseDebugLogging)
     {
         UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyComponent: Scalability test - VertexCount: %d, NumClusters: %d, Clusters Generated: %d."),
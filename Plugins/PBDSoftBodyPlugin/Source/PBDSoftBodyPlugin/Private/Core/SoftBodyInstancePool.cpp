@@ -0,0 +1,180 @@
+#include "SoftBodyInstancePool.h"
+#include "PBDSoftBodyComponent.h"
+#include "PBDSoftBodyPlugin.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
+#include "PBDSoftBodyPlugin/Private/Rendering/VertexBufferUpdater.h"
+#include "PBDSoftBodyPlugin/Private/Animation/AnimationBlender.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+
+USoftBodyInstancePool* USoftBodyInstancePool::Get(const UWorld* World)
+{
+    return World ? World->GetSubsystem<USoftBodyInstancePool>() : nullptr;
+}
+
+bool USoftBodyInstancePool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USoftBodyInstancePool::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    MaxInstancesPerMesh = 16;
+    const FString ConfigPath = FConfigCacheIni::NormalizeConfigIniPath(
+        FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("PBDSoftBodyPlugin/Config/PBDSoftBodyConfig.ini")));
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("PBDSoftBody"), TEXT("PoolMaxInstancesPerMesh"), MaxInstancesPerMesh, ConfigPath);
+        GConfig->GetArray(TEXT("PBDSoftBody"), TEXT("PoolPrewarm"), PrewarmEntries, ConfigPath);
+    }
+    MaxInstancesPerMesh = FMath::Max(MaxInstancesPerMesh, 0);
+}
+
+void USoftBodyInstancePool::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    for (const FString& Entry : PrewarmEntries)
+    {
+        FString MeshPath;
+        FString CountString;
+        if (!Entry.Split(TEXT(","), &MeshPath, &CountString))
+        {
+            MeshPath = Entry;
+            CountString = TEXT("1");
+        }
+        USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath.TrimStartAndEnd());
+        if (!Mesh)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SoftBodyInstancePool: Cannot prewarm '%s' - mesh not found."), *MeshPath);
+            continue;
+        }
+        Prewarm(Mesh, FCString::Atoi(*CountString.TrimStartAndEnd()));
+    }
+}
+
+void USoftBodyInstancePool::Deinitialize()
+{
+    Instances.Empty();
+    Super::Deinitialize();
+}
+
+bool USoftBodyInstancePool::Acquire(UPBDSoftBodyComponent* Component)
+{
+    const USkeletalMesh* Mesh = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+    if (!Mesh)
+    {
+        return false;
+    }
+
+    const uint32 SettingsHash = Component->GetPoolSettingsHash();
+    for (int32 InstanceIdx = Instances.Num() - 1; InstanceIdx >= 0; InstanceIdx--)
+    {
+        FSoftBodyPooledInstance& Instance = Instances[InstanceIdx];
+        if (Instance.Mesh == Mesh && Instance.SettingsHash == SettingsHash)
+        {
+            Component->AdoptPooledInstance(Instance);
+            Instances.RemoveAtSwap(InstanceIdx, EAllowShrinking::No);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool USoftBodyInstancePool::Release(UPBDSoftBodyComponent* Component)
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    USkeletalMesh* Mesh = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+    if (!Mesh || Component->SimulatedPositions.Num() == 0 || GetNumPooledInstances(Mesh) >= MaxInstancesPerMesh)
+    {
+        return false;
+    }
+
+    FSoftBodyPooledInstance& Instance = Instances.AddDefaulted_GetRef();
+    Instance.Mesh = Mesh;
+    Instance.SettingsHash = Component->GetPoolSettingsHash();
+    Component->MoveToPooledInstance(Instance);
+
+    // Helpers were created inside the component; re-outer them so the dead component is not kept alive through them
+    UObject* Helpers[] = { Instance.ClusterManager, Instance.VertexBufferUpdater, Instance.AnimationBlender, Instance.Solver };
+    for (UObject* Helper : Helpers)
+    {
+        if (Helper && Helper->GetOuter() != this)
+        {
+            Helper->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional);
+        }
+    }
+    return true;
+}
+
+int32 USoftBodyInstancePool::Prewarm(USkeletalMesh* Mesh, int32 Count)
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    if (!Mesh || Count <= 0)
+    {
+        return 0;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumAdded = 0;
+    for (int32 i = 0; i < Count; i++)
+    {
+        // A throwaway component carrying the default settings builds the instance in the reference pose
+        UPBDSoftBodyComponent* Builder = NewObject<UPBDSoftBodyComponent>(this, NAME_None, RF_Transient);
+        Builder->InitializeConfig();
+        Builder->SetSkeletalMeshAsset(Mesh);
+        Builder->CreateHelpers();
+        const bool bBuilt = Builder->InitializeSimulationData() && Release(Builder);
+        Builder->MarkAsGarbage();
+        if (!bBuilt)
+        {
+            break;
+        }
+        NumAdded++;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("SoftBodyInstancePool: Prewarmed %d of %d instances of %s in %.3f ms (%d pooled)."),
+        NumAdded, Count, *Mesh->GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0, GetNumPooledInstances(Mesh));
+    return NumAdded;
+}
+
+int32 USoftBodyInstancePool::GetNumPooledInstances(const USkeletalMesh* Mesh) const
+{
+    int32 Count = 0;
+    for (const FSoftBodyPooledInstance& Instance : Instances)
+    {
+        if (Instance.Mesh == Mesh)
+        {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+SIZE_T USoftBodyInstancePool::GetAllocatedSize(const USkeletalMesh* Mesh) const
+{
+    SIZE_T Size = 0;
+    for (const FSoftBodyPooledInstance& Instance : Instances)
+    {
+        if (Mesh && Instance.Mesh != Mesh)
+        {
+            continue;
+        }
+        Size += Instance.Clusters.GetAllocatedSize() + Instance.SectionRanges.GetAllocatedSize()
+            + Instance.ParticleLayout.ParticleToRenderVertex.GetAllocatedSize() + Instance.ParticleLayout.RenderToParticle.GetAllocatedSize()
+            + Instance.SimulatedPositions.GetAllocatedSize() + Instance.Velocities.GetAllocatedSize() + Instance.AnimatedPositions.GetAllocatedSize();
+        for (const FSoftBodyCluster& Cluster : Instance.Clusters)
+        {
+            Size += Cluster.VertexIndices.GetAllocatedSize() + Cluster.VertexOffsets.GetAllocatedSize();
+        }
+        Size += Instance.Solver ? Instance.Solver->GetAllocatedSize() : 0;
+        Size += Instance.VertexBufferUpdater ? Instance.VertexBufferUpdater->GetAllocatedSize() : 0;
+        Size += Instance.AnimationBlender ? Instance.AnimationBlender->GetAllocatedSize() : 0;
+    }
+    return Size;
+}
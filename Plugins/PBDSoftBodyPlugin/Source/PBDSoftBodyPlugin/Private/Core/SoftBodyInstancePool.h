@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SoftBodyCluster.h"
+#include "SoftBodySection.h"
+#include "SoftBodyParticleLayout.h"
+#include "SoftBodyInstancePool.generated.h"
+
+class UPBDSoftBodyComponent;
+class UClusterManager;
+class UVertexBufferUpdater;
+class UAnimationBlender;
+class USoftBodySolver;
+class USkeletalMesh;
+
+// Simulation state and helper objects of one component, parked while no component uses them.
+// Only interchangeable between components with the same mesh and layout-affecting settings (SettingsHash).
+USTRUCT()
+struct FSoftBodyPooledInstance
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    USkeletalMesh* Mesh = nullptr;
+
+    uint32 SettingsHash = 0;
+
+    UPROPERTY()
+    UClusterManager* ClusterManager = nullptr;
+
+    UPROPERTY()
+    UVertexBufferUpdater* VertexBufferUpdater = nullptr;
+
+    UPROPERTY()
+    UAnimationBlender* AnimationBlender = nullptr;
+
+    UPROPERTY()
+    USoftBodySolver* Solver = nullptr;
+
+    int32 NumClusters = 0;
+    TArray<FSoftBodyCluster> Clusters;
+    TArray<FSoftBodySectionRange> SectionRanges;
+    FSoftBodyParticleLayout ParticleLayout;
+    TArray<FVector> SimulatedPositions;
+    TArray<FVector> Velocities;
+    TArray<FVector> AnimatedPositions;
+};
+
+// Recycles soft body simulation instances across spawn/despawn, so a component whose mesh and settings match a
+// pooled instance skips clustering, layout, adjacency and solver builds and allocates nothing in BeginPlay.
+// Instances enter the pool when their component ends play, or up front through prewarming ([PBDSoftBody] PoolPrewarm).
+UCLASS()
+class PBDSOFTBODYPLUGIN_API USoftBodyInstancePool : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USoftBodyInstancePool* Get(const UWorld* World);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Moves a matching pooled instance into the component; false if none is available
+    bool Acquire(UPBDSoftBodyComponent* Component);
+
+    // Takes the component's simulation state and helpers; false (component untouched) if it has none or the pool for its mesh is full
+    bool Release(UPBDSoftBodyComponent* Component);
+
+    // Builds Count instances for Mesh with the default component settings from the plugin config; returns how many were added
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Pool")
+    int32 Prewarm(USkeletalMesh* Mesh, int32 Count);
+
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Pool")
+    int32 GetNumPooledInstances(const USkeletalMesh* Mesh) const;
+
+    // Heap bytes parked in the pool for Mesh, or for every mesh when null
+    SIZE_T GetAllocatedSize(const USkeletalMesh* Mesh = nullptr) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY(Transient)
+    TArray<FSoftBodyPooledInstance> Instances;
+
+    // "MeshPath,Count" entries read from the plugin config, built on world begin play
+    TArray<FString> PrewarmEntries;
+
+    int32 MaxInstancesPerMesh;
+};
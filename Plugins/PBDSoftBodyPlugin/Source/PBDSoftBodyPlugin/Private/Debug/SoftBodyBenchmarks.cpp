@@ -0,0 +1,441 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "PBDSoftBodyComponent.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/ClusterManager.h"
+#include "PBDSoftBodyPlugin/Private/Animation/AnimationBlender.h"
+#include "PBDSoftBodyPlugin/Private/Animation/SoftBodySkinning.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
+
+namespace SoftBodyBenchmarks
+{
+    // A component with no mesh, world or logging, for driving the plugin's own passes on synthetic data
+    static UPBDSoftBodyComponent* CreateBenchComponent()
+    {
+        UPBDSoftBodyComponent* Component = NewObject<UPBDSoftBodyComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+        Component->InitializeConfig();
+        Component->bEnableDebugLogging = false;
+        Component->bVerboseDebugLogging = false;
+        return Component;
+    }
+
+    static void RunBlendBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumVertices = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 45993;
+        const int32 NumClusters = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, NumVertices) : 45;
+        const int32 Iterations = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 200;
+
+        FRandomStream Random(0x5B0D);
+        TArray<FVector> RenderPositions;
+        RenderPositions.SetNumUninitialized(NumVertices);
+        for (FVector& Position : RenderPositions)
+        {
+            Position = FVector(Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(0.0f, 180.0f));
+        }
+
+        // One simulated section whose welded particles come in shuffled order, standing in for a spatial clusterer
+        // scattering render indices across the vertex buffer
+        UPBDSoftBodyComponent* Component = CreateBenchComponent();
+        Component->NumClusters = NumClusters;
+        Component->bEnableClusterSleeping = false;
+        FSoftBodySectionRange& Range = Component->SectionRanges.AddDefaulted_GetRef();
+        Range.SectionIndex = 0;
+        Range.NumVertices = NumVertices;
+        FSoftBodyWeldMap WeldMap;
+        WeldMap.UniqueVertices.SetNumUninitialized(NumVertices);
+        for (int32 i = 0; i < NumVertices; i++)
+        {
+            WeldMap.UniqueVertices[i] = i;
+        }
+        for (int32 i = NumVertices - 1; i > 0; i--)
+        {
+            WeldMap.UniqueVertices.Swap(i, Random.RandRange(0, i));
+        }
+        WeldMap.SectionOffsets = { 0, NumVertices };
+        WeldMap.RenderToUnique.SetNumUninitialized(NumVertices);
+        for (int32 i = 0; i < NumVertices; i++)
+        {
+            WeldMap.RenderToUnique[WeldMap.UniqueVertices[i]] = i;
+        }
+
+        UClusterManager* ClusterManager = NewObject<UClusterManager>(Component);
+        UAnimationBlender* AnimationBlender = NewObject<UAnimationBlender>(Component);
+        ClusterManager->GenerateClusters(Component, RenderPositions, WeldMap);
+
+        // Render indices each cluster held before the particle layout replaced them, for the render-ordered baseline
+        TArray<TArray<int32>> ClusterVertexIndices;
+        for (const FSoftBodyCluster& Cluster : Component->Clusters)
+        {
+            ClusterVertexIndices.Add(Cluster.VertexIndices);
+        }
+        ClusterManager->BuildParticleLayout(Component, WeldMap);
+
+        const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+        Component->AnimatedPositions.SetNumUninitialized(Layout.GetNumParticles());
+        for (int32 ParticleIdx = 0; ParticleIdx < Layout.GetNumParticles(); ParticleIdx++)
+        {
+            Component->AnimatedPositions[ParticleIdx] = RenderPositions[Layout.ParticleToRenderVertex[ParticleIdx]];
+        }
+        Component->SimulatedPositions.SetNumZeroed(Layout.GetNumParticles());
+        Component->Velocities.SetNumZeroed(Layout.GetNumParticles());
+
+        // Baseline: the same blend arithmetic as it ran before the particle layout, reading and writing render-ordered arrays
+        // through each cluster's scattered VertexIndices. That loop no longer ships, so it is reconstructed here.
+        TArray<FSoftBodyCluster> RenderOrderedClusters = Component->Clusters;
+        TArray<FVector> RenderSimulated;
+        RenderSimulated.SetNumZeroed(NumVertices);
+        const float BlendWeight = Component->SoftBodyBlendWeight;
+        auto BlendRenderOrdered = [&RenderOrderedClusters, &ClusterVertexIndices, &RenderPositions, &RenderSimulated, BlendWeight]()
+        {
+            for (int32 ClusterIdx = 0; ClusterIdx < RenderOrderedClusters.Num(); ClusterIdx++)
+            {
+                FSoftBodyCluster& Cluster = RenderOrderedClusters[ClusterIdx];
+                const TArray<int32>& VertexIndices = ClusterVertexIndices[ClusterIdx];
+                FVector AnimatedCentroid = FVector::ZeroVector;
+                for (int32 VertexIdx : VertexIndices)
+                {
+                    AnimatedCentroid += RenderPositions[VertexIdx];
+                }
+                AnimatedCentroid /= FMath::Max(VertexIndices.Num(), 1);
+                Cluster.CentroidPosition = FMath::Lerp(AnimatedCentroid, Cluster.CentroidPosition, BlendWeight);
+                for (int32 i = 0; i < VertexIndices.Num(); i++)
+                {
+                    const FVector AnimatedDeviation = RenderPositions[VertexIndices[i]] - AnimatedCentroid - Cluster.VertexOffsets[i];
+                    RenderSimulated[VertexIndices[i]] = Cluster.CentroidPosition + Cluster.VertexOffsets[i] + AnimatedDeviation;
+                }
+            }
+        };
+
+        BlendRenderOrdered();
+        const double RenderOrderedStart = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; i++)
+        {
+            BlendRenderOrdered();
+        }
+        const double RenderOrderedMs = (FPlatformTime::Seconds() - RenderOrderedStart) * 1000.0 / Iterations;
+
+        AnimationBlender->BlendClusters(Component);
+        const double BlendStart = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; i++)
+        {
+            AnimationBlender->BlendClusters(Component);
+        }
+        const double BlendMs = (FPlatformTime::Seconds() - BlendStart) * 1000.0 / Iterations;
+
+        UE_LOG(LogTemp, Log, TEXT("SoftBodyBenchmarks: Blend pass, %d shuffled vertices in %d clusters, %d iterations - render-ordered baseline: %.3f ms, UAnimationBlender::BlendClusters on the particle layout: %.3f ms (%.2fx)."),
+            NumVertices, Component->Clusters.Num(), Iterations, RenderOrderedMs, BlendMs, BlendMs > 0.0 ? RenderOrderedMs / BlendMs : 0.0);
+        Component->MarkAsGarbage();
+    }
+
+    // Skins every vertex with the shipped kernels, one call per vertex as UAnimationBlender makes them
+    static void SkinLinear(const TArray<FVector3f>& Rest, const TArray<FSoftBodySkinInfluences>& Influences, const TArray<FMatrix44f>& RefToLocals, TArray<FVector3f>& OutPositions)
+    {
+        for (int32 i = 0; i < Rest.Num(); i++)
+        {
+            OutPositions[i] = SoftBodySkinning::SkinPositionLinear(Influences[i], RefToLocals, Rest[i]);
+        }
+    }
+
+    static void SkinDualQuat(const TArray<FVector3f>& Rest, const TArray<FSoftBodySkinInfluences>& Influences, const TArray<FSoftBodyDualQuat>& BoneDualQuats, TArray<FVector3f>& OutPositions)
+    {
+        for (int32 i = 0; i < Rest.Num(); i++)
+        {
+            OutPositions[i] = SoftBodySkinning::SkinPositionDualQuat(Influences[i], BoneDualQuats, Rest[i]);
+        }
+    }
+
+    // Largest distance of any vertex from its rest position (cm)
+    static double MeasureMaxDeviation(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Rest)
+    {
+        double MaxDeviation = 0.0;
+        for (int32 i = 0; i < Positions.Num(); i++)
+        {
+            MaxDeviation = FMath::Max(MaxDeviation, static_cast<double>(FVector3f::Dist(Positions[i], Rest[i])));
+        }
+        return MaxDeviation;
+    }
+
+    // Mean distance from the limb axis of the vertices around the joint, relative to the rest radius
+    static double MeasureJointRadius(const TArray<FVector3f>& Positions, const TArray<FVector3f>& Rest, float JointHeight, float Radius)
+    {
+        double RadiusSum = 0.0;
+        int32 Count = 0;
+        for (int32 i = 0; i < Positions.Num(); i++)
+        {
+            if (FMath::Abs(Rest[i].Z - JointHeight) < 1.0f)
+            {
+                RadiusSum += FVector2f(Positions[i].X, Positions[i].Y).Size();
+                Count++;
+            }
+        }
+        return Count > 0 ? RadiusSum / (Count * Radius) : 1.0;
+    }
+
+    static void RunSkinningBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumVertices = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 45993;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+        const float TwistDegrees = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 120.0f;
+
+        // A cylindrical limb along Z with the joint halfway up; weights fade from the lower to the upper bone across it
+        const float Radius = 5.0f;
+        const float Length = 40.0f;
+        const float JointHeight = Length * 0.5f;
+        const float BlendHalfWidth = 5.0f;
+        FRandomStream Random(0x5B0D);
+        TArray<FVector3f> Rest;
+        TArray<FSoftBodySkinInfluences> Influences;
+        Rest.SetNumUninitialized(NumVertices);
+        Influences.SetNum(NumVertices);
+        for (int32 i = 0; i < NumVertices; i++)
+        {
+            const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+            const float Height = Random.FRandRange(0.0f, Length);
+            Rest[i] = FVector3f(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, Height);
+            const float UpperWeight = FMath::SmoothStep(JointHeight - BlendHalfWidth, JointHeight + BlendHalfWidth, Height);
+            Influences[i].Bones[0] = 0;
+            Influences[i].Bones[1] = 1;
+            Influences[i].Weights[0] = 1.0f - UpperWeight;
+            Influences[i].Weights[1] = UpperWeight;
+            Influences[i].Num = 2;
+        }
+
+        // Bind pose as a skeleton stores it: bones rotated and placed along the limb rather than at the identity, so the
+        // skinned positions are only right if the kernels go through the inverse reference pose
+        const FVector Pivot(0.0, 0.0, JointHeight);
+        const TArray<FTransform> RefPose =
+        {
+            FTransform(FQuat(FVector::ForwardVector, UE_HALF_PI), FVector(0.0, 0.0, 2.0)),
+            FTransform(FQuat(FVector(0.0, 1.0, 1.0).GetSafeNormal(), 0.6), Pivot),
+        };
+        TArray<FMatrix44f> RefBasesInvMatrix;
+        for (const FTransform& Bone : RefPose)
+        {
+            RefBasesInvMatrix.Add(FMatrix44f(Bone.ToMatrixWithScale().Inverse()));
+        }
+
+        // Upper bone twists about the limb axis, pivoting at the joint; component space, as GetSkinningBoneTransforms returns it
+        const FQuat Twist(FVector::UpVector, FMath::DegreesToRadians(TwistDegrees));
+        const TArray<FTransform> BoneTransforms = { RefPose[0], RefPose[1] * FTransform(Twist, Pivot - Twist.RotateVector(Pivot)) };
+
+        TArray<FVector3f> Skinned;
+        Skinned.SetNumZeroed(NumVertices);
+        TArray<FMatrix44f> RefToLocals;
+        TArray<FSoftBodyDualQuat> BoneDualQuats;
+
+        // In the bind pose both modes have to give back the rest positions
+        SoftBodySkinning::BuildRefToLocals(RefPose, RefBasesInvMatrix, RefToLocals);
+        SkinLinear(Rest, Influences, RefToLocals, Skinned);
+        const double LinearBindError = MeasureMaxDeviation(Skinned, Rest);
+        SoftBodySkinning::BuildBoneDualQuats(RefPose, RefBasesInvMatrix, BoneDualQuats);
+        SkinDualQuat(Rest, Influences, BoneDualQuats, Skinned);
+        const double DualQuatBindError = MeasureMaxDeviation(Skinned, Rest);
+
+        // Each timed iteration includes the per-bone setup the component pays per frame
+        const double LinearStart = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+        {
+            SoftBodySkinning::BuildRefToLocals(BoneTransforms, RefBasesInvMatrix, RefToLocals);
+            SkinLinear(Rest, Influences, RefToLocals, Skinned);
+        }
+        const double LinearMs = (FPlatformTime::Seconds() - LinearStart) * 1000.0 / Iterations;
+        const double LinearRadius = MeasureJointRadius(Skinned, Rest, JointHeight, Radius);
+
+        const double DualQuatStart = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+        {
+            SoftBodySkinning::BuildBoneDualQuats(BoneTransforms, RefBasesInvMatrix, BoneDualQuats);
+            SkinDualQuat(Rest, Influences, BoneDualQuats, Skinned);
+        }
+        const double DualQuatMs = (FPlatformTime::Seconds() - DualQuatStart) * 1000.0 / Iterations;
+        const double DualQuatRadius = MeasureJointRadius(Skinned, Rest, JointHeight, Radius);
+
+        UE_LOG(LogTemp, Log, TEXT("SoftBodyBenchmarks: Skinning, %d vertices, %d iterations, %.0f degree twist - linear: %.3f ms, %.1f%% of the joint radius kept, bind pose off by %.4f cm; dual quaternion: %.3f ms (%.2fx), %.1f%% kept, bind pose off by %.4f cm. Single-threaded."),
+            NumVertices, Iterations, TwistDegrees, LinearMs, LinearRadius * 100.0, LinearBindError,
+            DualQuatMs, LinearMs > 0.0 ? DualQuatMs / LinearMs : 0.0, DualQuatRadius * 100.0, DualQuatBindError);
+    }
+
+    // Largest edge length error left (cm)
+    static float MeasureEdgeError(const USoftBodySolver* Solver, const TArray<FVector>& Positions)
+    {
+        float MaxError = 0.0f;
+        for (const FSoftBodyDistanceConstraint& Constraint : Solver->GetConstraints())
+        {
+            MaxError = FMath::Max(MaxError, static_cast<float>(FMath::Abs(FVector::Dist(Positions[Constraint.A], Positions[Constraint.B]) - Constraint.RestLength)));
+        }
+        return MaxError;
+    }
+
+    // One component step from the goal pose, as the first step after a reset runs. The first cluster stays asleep,
+    // which pins the sheet's top band to the animation the way a sleeping neighbour would.
+    static void StepSheet(UPBDSoftBodyComponent* Component, USoftBodySolver* Solver, const TArray<FVector>& Goals)
+    {
+        Component->SimulatedPositions = Goals;
+        Component->AnimatedPositions = Goals;
+        for (FVector& Velocity : Component->Velocities)
+        {
+            Velocity = FVector::ZeroVector;
+        }
+        for (int32 ClusterIdx = 0; ClusterIdx < Component->Clusters.Num(); ClusterIdx++)
+        {
+            Component->Clusters[ClusterIdx].bUpdatedThisFrame = ClusterIdx > 0;
+        }
+        Solver->ResetState(Component);
+        Solver->Step(Component, 1.0f / 60.0f);
+    }
+
+    static void RunSolverBenchmark(const TArray<FString>& Args)
+    {
+        const int32 GridSize = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 2) : 128;
+        UPBDSoftBodyComponent* Component = CreateBenchComponent();
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : Component->SolverIterations;
+        const int32 NumSolves = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 50;
+        const int32 MaxConvergenceIterations = 1500;
+        const int32 NumVertices = GridSize * GridSize;
+        if (Args.Num() > 3)
+        {
+            Component->NumClusters = FMath::Clamp(FCString::Atoi(*Args[3]), 2, NumVertices);
+        }
+
+        // A hanging sheet, one simulated section in row-major render order, so UClusterManager cuts it into horizontal bands
+        // and BuildClusterHierarchy merges consecutive bands into super-clusters, as it does on a mesh
+        TArray<FVector> RenderRest;
+        RenderRest.SetNumUninitialized(NumVertices);
+        for (int32 Y = 0; Y < GridSize; Y++)
+        {
+            for (int32 X = 0; X < GridSize; X++)
+            {
+                RenderRest[Y * GridSize + X] = FVector(X, 0.0, -Y);
+            }
+        }
+        FSoftBodySectionRange& Range = Component->SectionRanges.AddDefaulted_GetRef();
+        Range.SectionIndex = 0;
+        Range.NumVertices = NumVertices;
+        FSoftBodyWeldMap WeldMap;
+        WeldMap.UniqueVertices.SetNumUninitialized(NumVertices);
+        WeldMap.RenderToUnique.SetNumUninitialized(NumVertices);
+        for (int32 i = 0; i < NumVertices; i++)
+        {
+            WeldMap.UniqueVertices[i] = i;
+            WeldMap.RenderToUnique[i] = i;
+        }
+        WeldMap.SectionOffsets = { 0, NumVertices };
+
+        UClusterManager* ClusterManager = NewObject<UClusterManager>(Component);
+        USoftBodySolver* Solver = NewObject<USoftBodySolver>(Component);
+        ClusterManager->GenerateClusters(Component, RenderRest, WeldMap);
+        ClusterManager->BuildParticleLayout(Component, WeldMap);
+
+        const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+        const int32 NumParticles = Layout.GetNumParticles();
+        TArray<int32> ParticleTriangles;
+        for (int32 Y = 0; Y + 1 < GridSize; Y++)
+        {
+            for (int32 X = 0; X + 1 < GridSize; X++)
+            {
+                const int32 A = Layout.RenderToParticle[Y * GridSize + X];
+                const int32 B = Layout.RenderToParticle[Y * GridSize + X + 1];
+                const int32 C = Layout.RenderToParticle[(Y + 1) * GridSize + X];
+                const int32 D = Layout.RenderToParticle[(Y + 1) * GridSize + X + 1];
+                ParticleTriangles.Append({ A, B, D, A, D, C });
+            }
+        }
+
+        // The animation stretches the sheet by a fifth and bulges it out of plane; the inextensible edges have to pull it back
+        // against the goal springs. The error is smooth across the whole sheet, which fine-level iterations remove slowly.
+        TArray<FVector> Rest;
+        TArray<FVector> Goals;
+        Rest.SetNumUninitialized(NumParticles);
+        Goals.SetNumUninitialized(NumParticles);
+        for (int32 ParticleIdx = 0; ParticleIdx < NumParticles; ParticleIdx++)
+        {
+            const FVector& RestPosition = RenderRest[Layout.ParticleToRenderVertex[ParticleIdx]];
+            const double Depth = -RestPosition.Z / (GridSize - 1);
+            Rest[ParticleIdx] = RestPosition;
+            Goals[ParticleIdx] = FVector(RestPosition.X, FMath::Sin(UE_PI * RestPosition.X / (GridSize - 1)) * Depth * GridSize * 0.1, RestPosition.Z * 1.2);
+        }
+        Component->Velocities.SetNumZeroed(NumParticles);
+
+        // The coarse levels the hierarchical variants get, straight from the clusterer
+        TArray<TArray<FSoftBodyClusterNode>> Hierarchy;
+        ClusterManager->BuildClusterHierarchy(Component, Component->SolverLevels - 1, Component->ClustersPerSuperCluster, Hierarchy);
+        FString HierarchyDesc;
+        for (const TArray<FSoftBodyClusterNode>& Level : Hierarchy)
+        {
+            HierarchyDesc += FString::Printf(TEXT("%s%d"), HierarchyDesc.IsEmpty() ? TEXT("") : TEXT(" + "), Level.Num());
+        }
+
+        struct FBenchVariant
+        {
+            const TCHAR* Name;
+            ESoftBodySolverMode Mode;
+            bool bHierarchical;
+        };
+        const FBenchVariant Variants[] =
+        {
+            { TEXT("Gauss-Seidel, flat"), ESoftBodySolverMode::GaussSeidel, false },
+            { TEXT("Gauss-Seidel, hierarchical"), ESoftBodySolverMode::GaussSeidel, true },
+            { TEXT("Jacobi+Chebyshev, flat"), ESoftBodySolverMode::Jacobi, false },
+            { TEXT("Jacobi+Chebyshev, hierarchical"), ESoftBodySolverMode::Jacobi, true },
+        };
+        bool bLoggedHeader = false;
+        for (const FBenchVariant& Variant : Variants)
+        {
+            Component->SolverMode = Variant.Mode;
+            Component->bHierarchicalSolver = Variant.bHierarchical;
+            Component->SimulatedPositions = Rest;
+            if (!Solver->Build(Component, ParticleTriangles, ClusterManager))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SoftBodyBenchmarks: Solver build failed for a %dx%d sheet."), GridSize, GridSize);
+                break;
+            }
+            if (!bLoggedHeader)
+            {
+                UE_LOG(LogTemp, Log, TEXT("SoftBodyBenchmarks: Solver, %d particles in %d clusters (coarse levels %s nodes), %d constraints in %d colors, tethers %s (%.1f cm), %d iterations (fewer on the fine level when hierarchical), %d solves - initial edge error %.3f cm."),
+                    NumParticles, Component->Clusters.Num(), HierarchyDesc.IsEmpty() ? TEXT("none") : *HierarchyDesc, Solver->GetNumConstraints(), Solver->GetNumColors(),
+                    Component->bEnableTethers ? TEXT("on") : TEXT("off"), Component->TetherRadius, Iterations, NumSolves, MeasureEdgeError(Solver, Goals));
+                bLoggedHeader = true;
+            }
+
+            Component->bAdaptiveIterations = false;
+            Component->SolverIterations = Iterations;
+            double SolveSeconds = 0.0;
+            for (int32 Solve = 0; Solve <= NumSolves; Solve++)
+            {
+                const double Start = FPlatformTime::Seconds();
+                StepSheet(Component, Solver, Goals);
+                SolveSeconds += Solve > 0 ? FPlatformTime::Seconds() - Start : 0.0;
+            }
+            const float FinalError = MeasureEdgeError(Solver, Component->SimulatedPositions);
+
+            // Convergence: fine iterations until the largest residual is under the component's tolerance
+            Component->bAdaptiveIterations = true;
+            Component->MinSolverIterations = 1;
+            Component->MaxSolverIterations = MaxConvergenceIterations;
+            StepSheet(Component, Solver, Goals);
+            const FSoftBodySimulationStats& Stats = Component->SimulationStats;
+
+            UE_LOG(LogTemp, Log, TEXT("  %-32s %8.3f ms/solve, edge error left %.4f cm, %s%d fine iterations to %.2f cm."),
+                Variant.Name, SolveSeconds * 1000.0 / NumSolves, FinalError,
+                Stats.SolverResidual > Component->ResidualTolerance ? TEXT(">") : TEXT(""), Stats.SolverIterationsUsed, Component->ResidualTolerance);
+        }
+        Component->MarkAsGarbage();
+    }
+
+    static FAutoConsoleCommand BlendBenchmarkCommand(
+        TEXT("PBDSoftBody.Benchmark.Blend"),
+        TEXT("Times UAnimationBlender::BlendClusters on a shuffled-index mesh laid out by UClusterManager against the render-ordered blend it replaced. Args: [NumVertices] [NumClusters] [Iterations]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBlendBenchmark));
+
+    static FAutoConsoleCommand SkinningBenchmarkCommand(
+        TEXT("PBDSoftBody.Benchmark.Skinning"),
+        TEXT("Times the linear blend and dual-quaternion skinning kernels on a twisted two-bone limb with a non-identity bind pose and reports how much of the joint's radius each keeps. Args: [NumVertices] [Iterations] [TwistDegrees]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunSkinningBenchmark));
+
+    static FAutoConsoleCommand SolverBenchmarkCommand(
+        TEXT("PBDSoftBody.Benchmark.Solver"),
+        TEXT("Steps USoftBodySolver on a stretched hanging sheet clustered by UClusterManager, flat and hierarchical, in Gauss-Seidel and Jacobi+Chebyshev modes with the component's config settings, and reports time per solve, the edge error left and the fine iterations needed to converge. Args: [GridSize] [Iterations] [Solves] [NumClusters]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunSolverBenchmark));
+}
\ No newline at end of file
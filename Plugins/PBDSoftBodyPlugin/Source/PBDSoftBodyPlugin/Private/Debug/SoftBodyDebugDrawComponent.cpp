@@ -0,0 +1,286 @@
+#include "SoftBodyDebugDrawComponent.h"
+#include "PBDSoftBodyComponent.h"
+#include "PBDSoftBodyPlugin.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
+#include "HAL/IConsoleManager.h"
+#include "PrimitiveSceneProxy.h"
+#include "SceneManagement.h"
+#include "Tasks/Task.h"
+
+static TAutoConsoleVariable<int32> CVarSoftBodyDebugDraw(
+    TEXT("PBDSoftBody.DebugDraw"),
+    0,
+    TEXT("Draws soft body simulation buffers.\n")
+    TEXT(" 0: off\n")
+    TEXT(" 1: particles and centroids colored by cluster\n")
+    TEXT(" 2: particles colored by sleep state (green awake, blue asleep, grey rigid)\n")
+    TEXT(" 3: edges colored by constraint error (green at rest length, red at 10% strain or more)\n")
+    TEXT(" 4: particles colored by update tier (green full, yellow reduced rate, blue frozen, grey animation only)"),
+    ECVF_Cheat);
+
+namespace
+{
+    constexpr float ParticlePointSize = 2.0f;
+    constexpr float CentroidPointSize = 8.0f;
+    constexpr float MaxDisplayedStrain = 0.1f;
+
+    const FColor RigidColor(128, 128, 128);
+
+    struct FDebugClusterInput
+    {
+        int32 ParticleStart;
+        int32 ParticleCount;
+        FVector CentroidPosition;
+        bool bIsSleeping;
+    };
+
+    // Game-thread copy of what the worker needs, so the simulation can keep running while it builds
+    struct FDebugDrawInput
+    {
+        ESoftBodyDebugDrawMode Mode = ESoftBodyDebugDrawMode::None;
+        ESoftBodyUpdateTier Tier = ESoftBodyUpdateTier::Full;
+        TArray<FVector> Positions;
+        TArray<FDebugClusterInput> Clusters;
+        TArray<FSoftBodySectionRange> RigidRanges;
+        TArray<FSoftBodyDistanceConstraint> Constraints;
+    };
+
+    FColor GetTierColor(ESoftBodyUpdateTier Tier)
+    {
+        switch (Tier)
+        {
+        case ESoftBodyUpdateTier::ReducedRate: return FColor::Yellow;
+        case ESoftBodyUpdateTier::Frozen: return FColor::Blue;
+        case ESoftBodyUpdateTier::AnimationOnly: return RigidColor;
+        default: return FColor::Green;
+        }
+    }
+
+    void AddParticlePoints(FSoftBodyDebugDrawData& Data, const TArray<FVector>& Positions, int32 First, int32 Count, const FColor& Color)
+    {
+        for (int32 ParticleIdx = First; ParticleIdx < First + Count; ParticleIdx++)
+        {
+            Data.Points.Add({ FVector3f(Positions[ParticleIdx]), Color, ParticlePointSize });
+        }
+    }
+
+    TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe> BuildDebugDrawData(const FDebugDrawInput& Input)
+    {
+        TSharedPtr<FSoftBodyDebugDrawData, ESPMode::ThreadSafe> Data = MakeShared<FSoftBodyDebugDrawData, ESPMode::ThreadSafe>();
+        const TArray<FVector>& Positions = Input.Positions;
+        Data->Bounds = FBox(Positions.GetData(), Positions.Num());
+
+        if (Input.Mode == ESoftBodyDebugDrawMode::ConstraintError)
+        {
+            Data->Lines.Reserve(Input.Constraints.Num());
+            for (const FSoftBodyDistanceConstraint& Constraint : Input.Constraints)
+            {
+                const FVector& Start = Positions[Constraint.A];
+                const FVector& End = Positions[Constraint.B];
+                const float Strain = Constraint.RestLength > UE_SMALL_NUMBER
+                    ? FMath::Abs(static_cast<float>(FVector::Dist(Start, End)) - Constraint.RestLength) / Constraint.RestLength
+                    : 0.0f;
+                const FColor Color = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, FMath::Min(Strain / MaxDisplayedStrain, 1.0f)).ToFColor(true);
+                Data->Lines.Add({ FVector3f(Start), FVector3f(End), Color });
+            }
+            return Data;
+        }
+
+        Data->Points.Reserve(Positions.Num() + Input.Clusters.Num());
+        if (Input.Mode == ESoftBodyDebugDrawMode::UpdateTier)
+        {
+            AddParticlePoints(*Data, Positions, 0, Positions.Num(), GetTierColor(Input.Tier));
+            return Data;
+        }
+
+        for (int32 ClusterIdx = 0; ClusterIdx < Input.Clusters.Num(); ClusterIdx++)
+        {
+            const FDebugClusterInput& Cluster = Input.Clusters[ClusterIdx];
+            const FColor Color = Input.Mode == ESoftBodyDebugDrawMode::ClusterId
+                ? FColor::MakeRandomSeededColor(ClusterIdx)
+                : (Cluster.bIsSleeping ? FColor::Blue : FColor::Green);
+            AddParticlePoints(*Data, Positions, Cluster.ParticleStart, Cluster.ParticleCount, Color);
+            Data->Points.Add({ FVector3f(Cluster.CentroidPosition), Color, CentroidPointSize });
+        }
+        for (const FSoftBodySectionRange& Range : Input.RigidRanges)
+        {
+            AddParticlePoints(*Data, Positions, Range.FirstParticle, Range.NumParticles, RigidColor);
+        }
+        return Data;
+    }
+}
+
+class FSoftBodyDebugDrawSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+    FSoftBodyDebugDrawSceneProxy(const USoftBodyDebugDrawComponent* InComponent, TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe> InData)
+        : FPrimitiveSceneProxy(InComponent)
+        , Data(MoveTemp(InData))
+    {
+    }
+
+    virtual SIZE_T GetTypeHash() const override
+    {
+        static size_t UniquePointer;
+        return reinterpret_cast<size_t>(&UniquePointer);
+    }
+
+    virtual uint32 GetMemoryFootprint() const override
+    {
+        return sizeof(*this) + GetAllocatedSize();
+    }
+
+    virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+    {
+        FPrimitiveViewRelevance Result;
+        Result.bDrawRelevance = IsShown(View);
+        Result.bDynamicRelevance = true;
+        Result.bShadowRelevance = false;
+        Result.bEditorPrimitiveRelevance = UseEditorCompositing(View);
+        return Result;
+    }
+
+    // Points and lines go through the view's batched element collector, so the whole set is a single draw
+    virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+    {
+        if (!Data.IsValid())
+        {
+            return;
+        }
+        const FMatrix& LocalToWorld = GetLocalToWorld();
+        for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+        {
+            if (!(VisibilityMap & (1 << ViewIndex)))
+            {
+                continue;
+            }
+            FPrimitiveDrawInterface* PDI = Collector.GetPDI(ViewIndex);
+            for (const FSoftBodyDebugPoint& Point : Data->Points)
+            {
+                PDI->DrawPoint(LocalToWorld.TransformPosition(FVector(Point.Position)), FLinearColor(Point.Color), Point.Size, SDPG_World);
+            }
+            for (const FSoftBodyDebugLine& Line : Data->Lines)
+            {
+                PDI->DrawLine(LocalToWorld.TransformPosition(FVector(Line.Start)), LocalToWorld.TransformPosition(FVector(Line.End)), FLinearColor(Line.Color), SDPG_World);
+            }
+        }
+    }
+
+    void SetData_RenderThread(TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe> InData)
+    {
+        Data = MoveTemp(InData);
+    }
+
+private:
+    TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe> Data;
+};
+
+USoftBodyDebugDrawComponent::USoftBodyDebugDrawComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SetGenerateOverlapEvents(false);
+    CastShadow = false;
+    bSelectable = false;
+    bIsEditorOnly = false;
+}
+
+ESoftBodyDebugDrawMode USoftBodyDebugDrawComponent::GetRequestedMode()
+{
+    const int32 Value = CVarSoftBodyDebugDraw.GetValueOnGameThread();
+    return Value > 0 && Value < static_cast<int32>(ESoftBodyDebugDrawMode::Count) ? static_cast<ESoftBodyDebugDrawMode>(Value) : ESoftBodyDebugDrawMode::None;
+}
+
+void USoftBodyDebugDrawComponent::UpdateFromSimulation(const UPBDSoftBodyComponent* Component, const USoftBodySolver* Solver, ESoftBodyDebugDrawMode Mode)
+{
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+    if (BuildTask.IsValid())
+    {
+        // Still building the previous frame; keep showing what we have
+        if (!BuildTask.IsCompleted())
+        {
+            return;
+        }
+        CurrentData = BuildTask.GetResult();
+        BuildTask = {};
+        UpdateBounds();
+        MarkRenderTransformDirty();
+        MarkRenderDynamicDataDirty();
+    }
+
+    if (!Component || Component->SimulatedPositions.Num() == 0)
+    {
+        return;
+    }
+
+    FDebugDrawInput Input;
+    Input.Mode = Mode;
+    Input.Tier = Component->SimulationStats.UpdateTier;
+    Input.Positions = Component->SimulatedPositions;
+    if (Mode == ESoftBodyDebugDrawMode::ConstraintError)
+    {
+        if (!IsValid(Solver) || Solver->GetNumConstraints() == 0)
+        {
+            return;
+        }
+        Input.Constraints = Solver->GetConstraints();
+    }
+    else
+    {
+        Input.Clusters.Reserve(Component->Clusters.Num());
+        for (const FSoftBodyCluster& Cluster : Component->Clusters)
+        {
+            Input.Clusters.Add({ Cluster.ParticleStart, Cluster.ParticleCount, Cluster.CentroidPosition, Cluster.bIsSleeping });
+        }
+        for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+        {
+            if (Range.Mode == ESoftBodySectionMode::Rigid)
+            {
+                Input.RigidRanges.Add(Range);
+            }
+        }
+    }
+
+    BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Input = MoveTemp(Input)]()
+    {
+        LLM_SCOPE_BYTAG(PBDSoftBody);
+        return BuildDebugDrawData(Input);
+    });
+}
+
+FPrimitiveSceneProxy* USoftBodyDebugDrawComponent::CreateSceneProxy()
+{
+    return new FSoftBodyDebugDrawSceneProxy(this, CurrentData);
+}
+
+FBoxSphereBounds USoftBodyDebugDrawComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+    if (CurrentData.IsValid() && CurrentData->Bounds.IsValid)
+    {
+        return FBoxSphereBounds(CurrentData->Bounds).TransformBy(LocalToWorld);
+    }
+    return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0);
+}
+
+void USoftBodyDebugDrawComponent::OnUnregister()
+{
+    if (BuildTask.IsValid())
+    {
+        BuildTask.Wait();
+        BuildTask = {};
+    }
+    Super::OnUnregister();
+}
+
+void USoftBodyDebugDrawComponent::SendRenderDynamicData_Concurrent()
+{
+    Super::SendRenderDynamicData_Concurrent();
+    if (SceneProxy)
+    {
+        FSoftBodyDebugDrawSceneProxy* Proxy = static_cast<FSoftBodyDebugDrawSceneProxy*>(SceneProxy);
+        ENQUEUE_RENDER_COMMAND(SoftBodyDebugDrawData)([Proxy, Data = CurrentData](FRHICommandListImmediate& RHICmdList)
+        {
+            Proxy->SetData_RenderThread(Data);
+        });
+    }
+}
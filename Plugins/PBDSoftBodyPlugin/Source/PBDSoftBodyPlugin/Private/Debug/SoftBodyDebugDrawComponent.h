@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Tasks/Task.h"
+#include "SoftBodyDebugDrawComponent.generated.h"
+
+class UPBDSoftBodyComponent;
+class USoftBodySolver;
+
+// Values of the PBDSoftBody.DebugDraw console variable
+enum class ESoftBodyDebugDrawMode : int32
+{
+    None,
+    ClusterId,
+    SleepState,
+    ConstraintError,
+    UpdateTier,
+    Count
+};
+
+struct FSoftBodyDebugPoint
+{
+    FVector3f Position;
+    FColor Color;
+    float Size;
+};
+
+struct FSoftBodyDebugLine
+{
+    FVector3f Start;
+    FVector3f End;
+    FColor Color;
+};
+
+// Everything the proxy draws, in the simulated component's space. Immutable once built, shared with the render thread.
+struct FSoftBodyDebugDrawData
+{
+    TArray<FSoftBodyDebugPoint> Points;
+    TArray<FSoftBodyDebugLine> Lines;
+    FBox Bounds = FBox(ForceInit);
+};
+
+// Draws a soft body's particles, cluster centroids or edges as one dynamic primitive. The draw data is built on a
+// worker from a copy of the simulation buffers and reaches the proxy a frame later.
+UCLASS(ClassGroup = Debug, Transient)
+class PBDSOFTBODYPLUGIN_API USoftBodyDebugDrawComponent : public UPrimitiveComponent
+{
+    GENERATED_BODY()
+
+public:
+    USoftBodyDebugDrawComponent();
+
+    // Mode selected by PBDSoftBody.DebugDraw; None when debug drawing is off
+    static ESoftBodyDebugDrawMode GetRequestedMode();
+
+    // Publishes the last finished build and, if the worker is free, starts the next one from the component's current state
+    void UpdateFromSimulation(const UPBDSoftBodyComponent* Component, const USoftBodySolver* Solver, ESoftBodyDebugDrawMode Mode);
+
+    virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+    virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+    virtual void OnUnregister() override;
+
+protected:
+    virtual void SendRenderDynamicData_Concurrent() override;
+
+private:
+    UE::Tasks::TTask<TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe>> BuildTask;
+    TSharedPtr<const FSoftBodyDebugDrawData, ESPMode::ThreadSafe> CurrentData;
+};
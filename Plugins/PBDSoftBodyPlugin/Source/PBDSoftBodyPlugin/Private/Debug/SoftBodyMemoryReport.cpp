@@ -0,0 +1,104 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+#include "PBDSoftBodyComponent.h"
+#include "SoftBodyInstancePool.h"
+
+namespace SoftBodyMemoryReport
+{
+    struct FMeshTotals
+    {
+        int32 NumInstances = 0;
+        int32 NumParticles = 0;
+        FSoftBodyMemoryUsage Usage;
+        // MeshDataBytes of the largest instance; everything beyond one copy is duplicated per instance
+        SIZE_T MeshDataPerInstance = 0;
+        TSet<const UWorld*> Worlds;
+    };
+
+    static double ToKB(SIZE_T Bytes)
+    {
+        return Bytes / 1024.0;
+    }
+
+    static void LogUsage(const TCHAR* Label, const FSoftBodyMemoryUsage& Usage, int32 NumParticles)
+    {
+        UE_LOG(LogTemp, Log, TEXT("  %-48s %8d particles %10.1f KB  (sim %.1f, mesh data %.1f, upload %.1f, scratch %.1f, cache %.1f) %6.1f B/particle"),
+            Label, NumParticles, ToKB(Usage.GetTotal()),
+            ToKB(Usage.SimulationBytes), ToKB(Usage.MeshDataBytes), ToKB(Usage.UploadBytes), ToKB(Usage.ScratchBytes), ToKB(Usage.CacheBytes),
+            NumParticles > 0 ? static_cast<double>(Usage.GetTotal()) / NumParticles : 0.0);
+    }
+
+    // Args: [verbose] - lists every component, not just the per-mesh totals
+    static void RunMemReport(const TArray<FString>& Args)
+    {
+        const bool bVerbose = Args.Num() > 0 && Args[0].Equals(TEXT("verbose"), ESearchCase::IgnoreCase);
+
+        TMap<const USkeletalMesh*, FMeshTotals> MeshTotals;
+        FSoftBodyMemoryUsage GrandTotal;
+        int32 TotalParticles = 0;
+
+        UE_LOG(LogTemp, Log, TEXT("SoftBodyMemoryReport: Per-component heap memory (KB), LLM tag PBDSoftBody:"));
+        for (TObjectIterator<UPBDSoftBodyComponent> It; It; ++It)
+        {
+            const UPBDSoftBodyComponent* Component = *It;
+            if (Component->IsTemplate() || !Component->GetWorld())
+            {
+                continue;
+            }
+
+            FSoftBodyMemoryUsage Usage;
+            Component->GetMemoryUsage(Usage);
+            const int32 NumParticles = Component->SimulatedPositions.Num();
+            const USkeletalMesh* Mesh = Component->GetSkeletalMeshAsset();
+
+            FMeshTotals& Totals = MeshTotals.FindOrAdd(Mesh);
+            Totals.NumInstances++;
+            Totals.NumParticles += NumParticles;
+            Totals.Usage += Usage;
+            Totals.MeshDataPerInstance = FMath::Max(Totals.MeshDataPerInstance, Usage.MeshDataBytes);
+            Totals.Worlds.Add(Component->GetWorld());
+            GrandTotal += Usage;
+            TotalParticles += NumParticles;
+
+            if (bVerbose)
+            {
+                const AActor* Owner = Component->GetOwner();
+                const FString Label = FString::Printf(TEXT("%s.%s"), Owner ? *Owner->GetName() : TEXT("<none>"), *Component->GetName());
+                LogUsage(*Label, Usage, NumParticles);
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("SoftBodyMemoryReport: Per-mesh totals:"));
+        for (const TPair<const USkeletalMesh*, FMeshTotals>& Pair : MeshTotals)
+        {
+            const FMeshTotals& Totals = Pair.Value;
+            const FString Label = FString::Printf(TEXT("%s x%d"), Pair.Key ? *Pair.Key->GetName() : TEXT("<no mesh>"), Totals.NumInstances);
+            LogUsage(*Label, Totals.Usage, Totals.NumParticles);
+
+            const SIZE_T DuplicatedBytes = Totals.Usage.MeshDataBytes - FMath::Min(Totals.Usage.MeshDataBytes, Totals.MeshDataPerInstance);
+            SIZE_T PooledBytes = 0;
+            int32 NumPooled = 0;
+            for (const UWorld* World : Totals.Worlds)
+            {
+                if (const USoftBodyInstancePool* Pool = USoftBodyInstancePool::Get(World))
+                {
+                    PooledBytes += Pool->GetAllocatedSize(Pair.Key);
+                    NumPooled += Pool->GetNumPooledInstances(Pair.Key);
+                }
+            }
+            UE_LOG(LogTemp, Log, TEXT("    mesh data duplicated across instances: %.1f KB; pooled: %d instances, %.1f KB"),
+                ToKB(DuplicatedBytes), NumPooled, ToKB(PooledBytes));
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("SoftBodyMemoryReport: Total:"));
+        LogUsage(TEXT("All components"), GrandTotal, TotalParticles);
+    }
+
+    static FAutoConsoleCommand MemReportCommand(
+        TEXT("PBDSoftBody.MemReport"),
+        TEXT("Logs the heap memory held by soft body components, per mesh and in total, split into simulation state, per-mesh data, upload staging, scratch and delta cache. Args: [verbose]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunMemReport));
+}
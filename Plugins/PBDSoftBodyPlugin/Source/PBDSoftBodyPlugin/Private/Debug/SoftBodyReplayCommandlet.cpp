@@ -0,0 +1,338 @@
+#include "SoftBodyReplayCommandlet.h"
+#include "PBDSoftBodyComponent.h"
+#include "PBDSoftBodyPlugin.h"
+#include "PBDSoftBodyPlugin/Private/Animation/AnimationBlender.h"
+#include "PBDSoftBodyPlugin/Private/Animation/SoftBodyBoneRecorder.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
+#include "PBDSoftBodyPlugin/Private/Rendering/VertexBufferUpdater.h"
+#include "PBDSoftBodyPlugin/Private/Cache/VertexDeltaCache.h"
+#include "Engine/SkeletalMesh.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace SoftBodyReplay
+{
+    enum EStage
+    {
+        Skin,
+        Blend,
+        Solve,
+        Pack,
+        Tangents,
+        NumStages
+    };
+
+    static const TCHAR* StageNames[NumStages] = { TEXT("Skin"), TEXT("Blend"), TEXT("Solve"), TEXT("Pack"), TEXT("Tangents") };
+
+    struct FFrameSample
+    {
+        float DeltaTime = 0.0f;
+        float StageMs[NumStages] = {};
+        int32 SimulatedVertices = 0;
+        int32 SolverIterations = 0;
+        float SolverResidual = 0.0f;
+    };
+
+    static float Percentile(const TArray<float>& SortedValues, float Fraction)
+    {
+        const int32 Index = FMath::Clamp(FMath::CeilToInt32(Fraction * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+        return SortedValues[Index];
+    }
+
+    // Decodes every frame of the cache written during the replay, timing DecodeFrame as cache playback calls it, and
+    // compares the result against the replayed positions. The skin, blend and solve time of the same frames is what
+    // playback saves; packing and tangents run either way.
+    static void ReportDeltaCache(const FString& CachePath, const TArray<FVector3f>& ReplayedPositions, int32 NumParticles,
+        const TArray<FFrameSample>& Samples, int64 CacheBytes)
+    {
+        UVertexDeltaCache* Cache = NewObject<UVertexDeltaCache>(GetTransientPackage(), NAME_None, RF_Transient);
+        if (!Cache->Open(CachePath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SoftBodyReplayCommandlet: Failed to reopen the delta cache %s."), *CachePath);
+            return;
+        }
+
+        const int32 NumFrames = Cache->GetNumFrames();
+        TArray<FVector> Decoded;
+        Decoded.SetNumZeroed(NumParticles);
+        double DecodeSeconds = 0.0;
+        double SimulateMs = 0.0;
+        double MaxError = 0.0;
+        for (int32 Frame = 0; Frame < NumFrames; Frame++)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bDecoded = Cache->DecodeFrame(Frame, Decoded);
+            DecodeSeconds += FPlatformTime::Seconds() - StartTime;
+            if (!bDecoded)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SoftBodyReplayCommandlet: Failed to decode frame %d of %s."), Frame, *CachePath);
+                Cache->Close();
+                return;
+            }
+
+            SimulateMs += Samples[Frame].StageMs[Skin] + Samples[Frame].StageMs[Blend] + Samples[Frame].StageMs[Solve];
+            const FVector3f* Replayed = ReplayedPositions.GetData() + static_cast<int64>(Frame) * NumParticles;
+            for (int32 ParticleIdx = 0; ParticleIdx < NumParticles; ParticleIdx++)
+            {
+                MaxError = FMath::Max(MaxError, FVector::Dist(FVector(Replayed[ParticleIdx]), Decoded[ParticleIdx]));
+            }
+        }
+        Cache->Close();
+
+        const double DecodeMs = DecodeSeconds * 1000.0 / NumFrames;
+        SimulateMs /= NumFrames;
+        UE_LOG(LogTemp, Display, TEXT("SoftBodyReplayCommandlet: Delta cache, %d frames - decode %.3f ms/frame against %.3f ms/frame skin + blend + solve (%.2fx), %.1f bytes/particle/frame (%lld bytes), max error %.5f cm."),
+            NumFrames, DecodeMs, SimulateMs, DecodeMs > 0.0 ? SimulateMs / DecodeMs : 0.0,
+            static_cast<double>(CacheBytes) / (static_cast<double>(NumParticles) * NumFrames), CacheBytes, MaxError);
+    }
+}
+
+USoftBodyReplayCommandlet::USoftBodyReplayCommandlet()
+{
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 USoftBodyReplayCommandlet::Main(const FString& Params)
+{
+    using namespace SoftBodyReplay;
+    LLM_SCOPE_BYTAG(PBDSoftBody);
+
+    FString RecordingPath;
+    if (!FParse::Value(*Params, TEXT("Recording="), RecordingPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SoftBodyReplayCommandlet: Usage: -run=SoftBodyReplay -Recording=<file> [-Loops=N] [-Warmup=N] [-Csv=<file>] [-DeltaCache[=<file>]]"));
+        return 1;
+    }
+    int32 NumLoops = 1;
+    int32 NumWarmupFrames = 0;
+    FString CsvPath;
+    FParse::Value(*Params, TEXT("Loops="), NumLoops);
+    FParse::Value(*Params, TEXT("Warmup="), NumWarmupFrames);
+    FParse::Value(*Params, TEXT("Csv="), CsvPath);
+    FString DeltaCachePath;
+    const bool bDeltaCache = FParse::Value(*Params, TEXT("DeltaCache="), DeltaCachePath) || FParse::Param(*Params, TEXT("DeltaCache"));
+    const bool bKeepDeltaCache = !DeltaCachePath.IsEmpty();
+    if (!bKeepDeltaCache)
+    {
+        DeltaCachePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PBDSoftBody"), TEXT("Replay.pbdc"));
+    }
+    else if (FPaths::IsRelative(DeltaCachePath))
+    {
+        DeltaCachePath = FPaths::Combine(FPaths::ProjectDir(), DeltaCachePath);
+    }
+    NumLoops = FMath::Max(NumLoops, 1);
+    NumWarmupFrames = FMath::Max(NumWarmupFrames, 0);
+    if (FPaths::IsRelative(RecordingPath))
+    {
+        RecordingPath = FPaths::Combine(FPaths::ProjectDir(), RecordingPath);
+    }
+
+    FSoftBodyBoneRecording Recording;
+    if (!Recording.Load(RecordingPath))
+    {
+        return 1;
+    }
+
+    USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *Recording.MeshPath);
+    if (!Mesh)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SoftBodyReplayCommandlet: Recorded mesh %s not found."), *Recording.MeshPath);
+        return 1;
+    }
+    if (Mesh->GetRefSkeleton().GetNum() != Recording.NumBones)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SoftBodyReplayCommandlet: %s has %d bones, the recording %d."),
+            *Mesh->GetName(), Mesh->GetRefSkeleton().GetNum(), Recording.NumBones);
+        return 1;
+    }
+
+    // Built the way a spawned component builds itself, in the reference pose; no world, so nothing is registered or rendered
+    UPBDSoftBodyComponent* Component = NewObject<UPBDSoftBodyComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+    Component->AddToRoot();
+    Component->InitializeConfig();
+    Component->bEnableDebugLogging = false;
+    Component->bVerboseDebugLogging = false;
+    Component->SetSkeletalMeshAsset(Mesh);
+    Component->CreateHelpers();
+
+    const double InitStartTime = FPlatformTime::Seconds();
+    if (!Component->InitializeSimulationData() || !IsValid(Component->AnimationBlender) || !IsValid(Component->VertexBufferUpdater))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SoftBodyReplayCommandlet: Failed to initialize the simulation for %s."), *Mesh->GetName());
+        Component->RemoveFromRoot();
+        return 1;
+    }
+    const double InitMs = (FPlatformTime::Seconds() - InitStartTime) * 1000.0;
+
+    UAnimationBlender* AnimationBlender = Component->AnimationBlender;
+    USoftBodySolver* Solver = Component->bEnableSolver && IsValid(Component->Solver) ? Component->Solver : nullptr;
+    UVertexBufferUpdater* VertexBufferUpdater = Component->VertexBufferUpdater;
+
+    const int32 NumRecordedFrames = Recording.GetNumFrames();
+    const int32 NumReplayFrames = NumWarmupFrames + NumLoops * NumRecordedFrames;
+    TArray<FFrameSample> Samples;
+    Samples.Reserve(NumLoops * NumRecordedFrames);
+
+    // The first measured loop is also written to a delta cache, outside the stage timings, along with the positions it
+    // should decode to
+    FVertexDeltaCacheWriter CacheWriter;
+    TArray<FVector3f> CachedPositions;
+    bool bWriteDeltaCache = false;
+    if (bDeltaCache)
+    {
+        float RecordedSeconds = 0.0f;
+        for (const float RecordedDeltaTime : Recording.DeltaTimes)
+        {
+            RecordedSeconds += RecordedDeltaTime;
+        }
+        TArray<FSoftBodyDeltaCacheClusterRange> CacheRanges;
+        TArray<FVector3f> RestOffsets;
+        Component->GetDeltaCacheLayout(CacheRanges, RestOffsets);
+        bWriteDeltaCache = CacheWriter.Open(DeltaCachePath, CacheRanges, RestOffsets,
+            RecordedSeconds > 0.0f ? NumRecordedFrames / RecordedSeconds : 30.0f, Component->DeltaCacheFramesPerChunk);
+        if (bWriteDeltaCache)
+        {
+            CachedPositions.Reserve(static_cast<int64>(NumRecordedFrames) * Component->SimulatedPositions.Num());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SoftBodyReplayCommandlet: Failed to open %s for the delta cache comparison."), *DeltaCachePath);
+        }
+    }
+
+    for (int32 ReplayFrame = 0; ReplayFrame < NumReplayFrames; ReplayFrame++)
+    {
+        const int32 FrameIdx = ReplayFrame % NumRecordedFrames;
+        Recording.GetFrame(FrameIdx, Component->BoneTransformOverride);
+        const float DeltaTime = Recording.DeltaTimes[FrameIdx];
+
+        FSoftBodySimulationStats& Stats = Component->SimulationStats;
+        Stats.ResetFrameCounters();
+
+        const double UpdateStartTime = FPlatformTime::Seconds();
+        AnimationBlender->UpdateBlendedPositions(Component);
+        const double SolveStartTime = FPlatformTime::Seconds();
+        if (Solver && Stats.SimulatedVertices > 0)
+        {
+            Solver->Step(Component, DeltaTime);
+        }
+        const double PackStartTime = FPlatformTime::Seconds();
+        const bool bPacked = Stats.SimulatedVertices > 0 && VertexBufferUpdater->PackPositions(Component);
+        const double TangentsStartTime = FPlatformTime::Seconds();
+        if (bPacked && Component->bRecomputeTangents)
+        {
+            VertexBufferUpdater->RecomputeTangents(Component);
+        }
+        const double EndTime = FPlatformTime::Seconds();
+
+        if (ReplayFrame < NumWarmupFrames)
+        {
+            continue;
+        }
+        FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+        Sample.DeltaTime = DeltaTime;
+        Sample.StageMs[Skin] = Stats.SkinTimeMs;
+        Sample.StageMs[Blend] = FMath::Max(static_cast<float>((SolveStartTime - UpdateStartTime) * 1000.0) - Stats.SkinTimeMs, 0.0f);
+        Sample.StageMs[Solve] = static_cast<float>((PackStartTime - SolveStartTime) * 1000.0);
+        Sample.StageMs[Pack] = static_cast<float>((TangentsStartTime - PackStartTime) * 1000.0);
+        Sample.StageMs[Tangents] = static_cast<float>((EndTime - TangentsStartTime) * 1000.0);
+        Sample.SimulatedVertices = Stats.SimulatedVertices;
+        Sample.SolverIterations = Stats.SolverIterationsUsed;
+        Sample.SolverResidual = Stats.SolverResidual;
+
+        if (bWriteDeltaCache && Samples.Num() <= NumRecordedFrames)
+        {
+            bWriteDeltaCache = CacheWriter.AddFrame(Component->SimulatedPositions);
+            for (const FVector& Position : Component->SimulatedPositions)
+            {
+                CachedPositions.Add(FVector3f(Position));
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("SoftBodyReplayCommandlet: %s, %d particles in %d clusters, %d bones; initialized in %.2f ms."),
+        *Mesh->GetName(), Component->SimulatedPositions.Num(), Component->Clusters.Num(), Recording.NumBones, InitMs);
+    UE_LOG(LogTemp, Display, TEXT("SoftBodyReplayCommandlet: Replayed %d frames (%d recorded x %d loops, %d warmup) with %s skinning, solver %s."),
+        Samples.Num(), NumRecordedFrames, NumLoops, NumWarmupFrames,
+        *StaticEnum<ESoftBodySkinningMode>()->GetNameStringByValue(static_cast<int64>(Component->SkinningMode)),
+        Solver ? TEXT("on") : TEXT("off"));
+
+    float TotalMean = 0.0f;
+    TArray<float> Values;
+    Values.Reserve(Samples.Num());
+    UE_LOG(LogTemp, Display, TEXT("  %-10s %10s %10s %10s %10s"), TEXT("Stage (ms)"), TEXT("mean"), TEXT("median"), TEXT("p95"), TEXT("max"));
+    for (int32 Stage = 0; Stage < NumStages; Stage++)
+    {
+        Values.Reset();
+        double Sum = 0.0;
+        for (const FFrameSample& Sample : Samples)
+        {
+            Values.Add(Sample.StageMs[Stage]);
+            Sum += Sample.StageMs[Stage];
+        }
+        Values.Sort();
+        const float Mean = static_cast<float>(Sum / FMath::Max(Samples.Num(), 1));
+        TotalMean += Mean;
+        UE_LOG(LogTemp, Display, TEXT("  %-10s %10.3f %10.3f %10.3f %10.3f"),
+            StageNames[Stage], Mean, Percentile(Values, 0.5f), Percentile(Values, 0.95f), Values.Last());
+    }
+
+    int64 SumSimulated = 0;
+    int64 SumIterations = 0;
+    for (const FFrameSample& Sample : Samples)
+    {
+        SumSimulated += Sample.SimulatedVertices;
+        SumIterations += Sample.SolverIterations;
+    }
+    UE_LOG(LogTemp, Display, TEXT("  %-10s %10.3f ms/frame; %.0f simulated vertices and %.2f solver iterations per frame on average."),
+        TEXT("Total"), TotalMean, static_cast<double>(SumSimulated) / Samples.Num(), static_cast<double>(SumIterations) / Samples.Num());
+
+    if (bDeltaCache)
+    {
+        if (bWriteDeltaCache && CacheWriter.Close())
+        {
+            ReportDeltaCache(DeltaCachePath, CachedPositions, Component->SimulatedPositions.Num(), Samples, CacheWriter.GetBytesWritten());
+        }
+        else
+        {
+            CacheWriter.Close();
+            UE_LOG(LogTemp, Warning, TEXT("SoftBodyReplayCommandlet: Failed to write the delta cache %s."), *DeltaCachePath);
+        }
+        if (!bKeepDeltaCache)
+        {
+            IFileManager::Get().Delete(*DeltaCachePath);
+        }
+    }
+
+    if (!CsvPath.IsEmpty())
+    {
+        FString Csv = TEXT("Frame,DeltaTime,SkinMs,BlendMs,SolveMs,PackMs,TangentsMs,SimulatedVertices,SolverIterations,SolverResidual\n");
+        for (int32 SampleIdx = 0; SampleIdx < Samples.Num(); SampleIdx++)
+        {
+            const FFrameSample& Sample = Samples[SampleIdx];
+            Csv += FString::Printf(TEXT("%d,%.6f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%.6f\n"), SampleIdx, Sample.DeltaTime,
+                Sample.StageMs[Skin], Sample.StageMs[Blend], Sample.StageMs[Solve], Sample.StageMs[Pack], Sample.StageMs[Tangents],
+                Sample.SimulatedVertices, Sample.SolverIterations, Sample.SolverResidual);
+        }
+        if (FPaths::IsRelative(CsvPath))
+        {
+            CsvPath = FPaths::Combine(FPaths::ProjectDir(), CsvPath);
+        }
+        if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+        {
+            UE_LOG(LogTemp, Display, TEXT("SoftBodyReplayCommandlet: Wrote per-frame timings to %s."), *CsvPath);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("SoftBodyReplayCommandlet: Failed to write %s."), *CsvPath);
+        }
+    }
+
+    Component->RemoveFromRoot();
+    return 0;
+}
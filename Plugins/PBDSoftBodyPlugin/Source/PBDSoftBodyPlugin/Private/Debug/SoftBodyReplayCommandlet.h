@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SoftBodyReplayCommandlet.generated.h"
+
+// Replays a bone transform recording (UPBDSoftBodyComponent::StartBoneRecording) through skinning, blending, the solver
+// and vertex packing on a component with no world, renderer or GPU, and logs per-stage timings.
+//
+//   UnrealEditor-Cmd <Project> -run=SoftBodyReplay -Recording=<file> [-Loops=N] [-Warmup=N] [-Csv=<file>] [-DeltaCache[=<file>]] -nullrhi
+//
+// Component settings come from the plugin config, as for a freshly spawned component. Warmup frames are replayed first
+// and left out of the statistics; Loops repeats the recorded frames, carrying the simulation state across.
+// DeltaCache writes the first measured loop to a vertex-delta cache and times decoding it against the skin, blend and
+// solve time of the same frames; the file is kept only when a path is given.
+UCLASS()
+class USoftBodyReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USoftBodyReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -2,6 +2,8 @@
 
 #define LOCTEXT_NAMESPACE "FPBDSoftBodyPluginModule"
 
+LLM_DEFINE_TAG(PBDSoftBody);
+
 void FPBDSoftBodyPluginModule::StartupModule()
 {
     UE_LOG(LogTemp, Log, TEXT("PBDSoftBodyPlugin: Module started."));
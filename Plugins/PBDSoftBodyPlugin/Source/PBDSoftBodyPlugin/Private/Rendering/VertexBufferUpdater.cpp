@@ -1,14 +1,261 @@
 #include "PBDSoftBodyPlugin/Private/Rendering/VertexBufferUpdater.h"
 #include "Rendering/SkeletalMeshRenderData.h"
+#include "Async/ParallelFor.h"
+#include "PackedNormal.h"
 #include "SoftBodyCluster.h"
 
+void UVertexBufferUpdater::BeginDestroy()
+{
+    Super::BeginDestroy();
+    UploadFence.BeginFence();
+}
+
+bool UVertexBufferUpdater::IsReadyForFinishDestroy()
+{
+    return Super::IsReadyForFinishDestroy() && UploadFence.IsFenceComplete();
+}
+
+bool UVertexBufferUpdater::PackPositions(const UPBDSoftBodyComponent* Component)
+{
+    const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+    if (!Layout.IsValid() || Layout.GetNumParticles() != Component->SimulatedPositions.Num())
+    {
+        return false;
+    }
+
+    // The previous upload may still be reading the staging buffer
+    UploadFence.Wait();
+
+    PackedPositions.SetNumUninitialized(Layout.RenderToParticle.Num(), EAllowShrinking::No);
+    UploadRanges.Reset();
+    UploadVertexCount = 0;
+
+    const FVector* Particles = Component->SimulatedPositions.GetData();
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Excluded || Range.NumVertices <= 0)
+        {
+            continue;
+        }
+
+        // Sequential writes in render order, reads from the contiguous particle array. A section whose vertices all
+        // welded into another section's particles owns none itself but is still packed.
+        for (int32 VertexIdx = Range.FirstVertex; VertexIdx < Range.FirstVertex + Range.NumVertices; VertexIdx++)
+        {
+            PackedPositions[VertexIdx] = FVector3f(Particles[Layout.RenderToParticle[VertexIdx]]);
+        }
+        UploadRanges.Add(Range);
+        UploadVertexCount += Range.NumVertices;
+    }
+    return UploadRanges.Num() > 0;
+}
+
+void UVertexBufferUpdater::BuildTangentData(const UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData)
+{
+    Indices.Reset();
+    VertexTriangleOffsets.Reset();
+    VertexTriangles.Reset();
+    RestTangentX.Reset();
+    RestTangentZ.Reset();
+    PackedTangents.Reset();
+    bTangentsInitialized = false;
+
+    const FStaticMeshVertexBuffer& TangentBuffer = LODRenderData.StaticVertexBuffers.StaticMeshVertexBuffer;
+    const FPositionVertexBuffer& PositionBuffer = LODRenderData.StaticVertexBuffers.PositionVertexBuffer;
+    const int32 NumVertices = PositionBuffer.GetNumVertices();
+    if (static_cast<int32>(TangentBuffer.GetNumVertices()) != NumVertices || !LODRenderData.MultiSizeIndexContainer.IsIndexBufferValid())
+    {
+        if (Component->bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: No CPU tangent or index data; tangents will not be recomputed."));
+        }
+        return;
+    }
+
+    LODRenderData.MultiSizeIndexContainer.GetIndexBuffer(Indices);
+    bUseHighPrecisionTangents = TangentBuffer.GetUseHighPrecisionTangentBasis();
+
+    // Count, prefix-sum, fill: only triangles of uploaded sections take part
+    VertexTriangleOffsets.SetNumZeroed(NumVertices + 1);
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Excluded)
+        {
+            continue;
+        }
+        const FSkelMeshRenderSection& Section = LODRenderData.RenderSections[Range.SectionIndex];
+        for (uint32 Index = Section.BaseIndex; Index < Section.BaseIndex + Section.NumTriangles * 3; Index++)
+        {
+            VertexTriangleOffsets[Indices[Index] + 1]++;
+        }
+    }
+    for (int32 VertexIdx = 0; VertexIdx < NumVertices; VertexIdx++)
+    {
+        VertexTriangleOffsets[VertexIdx + 1] += VertexTriangleOffsets[VertexIdx];
+    }
+
+    VertexTriangles.SetNumUninitialized(VertexTriangleOffsets[NumVertices]);
+    TArray<int32> FillCursor(VertexTriangleOffsets.GetData(), NumVertices);
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Excluded)
+        {
+            continue;
+        }
+        const FSkelMeshRenderSection& Section = LODRenderData.RenderSections[Range.SectionIndex];
+        const uint32 FirstTriangle = Section.BaseIndex / 3;
+        for (uint32 Triangle = FirstTriangle; Triangle < FirstTriangle + Section.NumTriangles; Triangle++)
+        {
+            for (uint32 Corner = 0; Corner < 3; Corner++)
+            {
+                VertexTriangles[FillCursor[Indices[Triangle * 3 + Corner]]++] = Triangle;
+            }
+        }
+    }
+
+    RestTangentX.SetNumZeroed(NumVertices);
+    RestTangentZ.SetNumZeroed(NumVertices);
+    double FaceNormalAgreement = 0.0;
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Excluded)
+        {
+            continue;
+        }
+        for (int32 VertexIdx = Range.FirstVertex; VertexIdx < Range.FirstVertex + Range.NumVertices; VertexIdx++)
+        {
+            RestTangentX[VertexIdx] = FVector3f(TangentBuffer.VertexTangentX(VertexIdx));
+            RestTangentZ[VertexIdx] = TangentBuffer.VertexTangentZ(VertexIdx);
+
+            // Learn the index winding from the rest pose rather than assuming it
+            FVector3f FaceNormalSum = FVector3f::ZeroVector;
+            for (int32 Adjacent = VertexTriangleOffsets[VertexIdx]; Adjacent < VertexTriangleOffsets[VertexIdx + 1]; Adjacent++)
+            {
+                const int32 Triangle = VertexTriangles[Adjacent];
+                const FVector3f& P0 = PositionBuffer.VertexPosition(Indices[Triangle * 3]);
+                const FVector3f& P1 = PositionBuffer.VertexPosition(Indices[Triangle * 3 + 1]);
+                const FVector3f& P2 = PositionBuffer.VertexPosition(Indices[Triangle * 3 + 2]);
+                FaceNormalSum += (P1 - P0) ^ (P2 - P0);
+            }
+            FaceNormalAgreement += FVector3f::DotProduct(FaceNormalSum.GetSafeNormal(), FVector3f(RestTangentZ[VertexIdx]));
+        }
+    }
+    FaceNormalSign = FaceNormalAgreement >= 0.0 ? 1.0f : -1.0f;
+
+    const int32 TangentElementSize = bUseHighPrecisionTangents ? sizeof(FPackedRGBA16N) : sizeof(FPackedNormal);
+    PackedTangents.SetNumZeroed(NumVertices * 2 * TangentElementSize);
+
+    if (Component->bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("VertexBufferUpdater: Built adjacency with %d vertex-triangle entries for %d vertices (%s tangents)."),
+            VertexTriangles.Num(), NumVertices, bUseHighPrecisionTangents ? TEXT("16-bit") : TEXT("8-bit"));
+    }
+}
+
+bool UVertexBufferUpdater::IsTangentFrameDirty(const FSoftBodyParticleLayout& Layout, int32 VertexIdx) const
+{
+    // A vertex's normal is built from its triangles, so it goes stale as soon as any corner of one of them moved,
+    // e.g. an asleep vertex on the border of an awake cluster
+    for (int32 Adjacent = VertexTriangleOffsets[VertexIdx]; Adjacent < VertexTriangleOffsets[VertexIdx + 1]; Adjacent++)
+    {
+        const int32 Triangle = VertexTriangles[Adjacent];
+        for (int32 Corner = 0; Corner < 3; Corner++)
+        {
+            if (DirtyParticles[Layout.RenderToParticle[Indices[Triangle * 3 + Corner]]])
+            {
+                return true;
+            }
+        }
+    }
+    return DirtyParticles[Layout.RenderToParticle[VertexIdx]] != 0;
+}
+
+bool UVertexBufferUpdater::RecomputeTangents(const UPBDSoftBodyComponent* Component)
+{
+    const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+    if (VertexTriangleOffsets.Num() != PackedPositions.Num() + 1 || PackedTangents.Num() == 0)
+    {
+        return false;
+    }
+
+    // Restrict to particles the blend pass rewrote this frame, plus their one-ring (see IsTangentFrameDirty); the first
+    // pass always covers everything
+    const bool bDirtyOnly = Component->bRecomputeTangentsDirtyOnly && bTangentsInitialized;
+    if (bDirtyOnly)
+    {
+        DirtyParticles.SetNumZeroed(Layout.GetNumParticles());
+        FMemory::Memzero(DirtyParticles.GetData(), DirtyParticles.Num());
+        for (const FSoftBodyCluster& Cluster : Component->Clusters)
+        {
+            if (Cluster.bUpdatedThisFrame)
+            {
+                FMemory::Memset(DirtyParticles.GetData() + Cluster.ParticleStart, 1, Cluster.ParticleCount);
+            }
+        }
+        for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+        {
+            if (Range.Mode == ESoftBodySectionMode::Rigid)
+            {
+                FMemory::Memset(DirtyParticles.GetData() + Range.FirstParticle, 1, Range.NumParticles);
+            }
+        }
+    }
+
+    const FVector3f* Positions = PackedPositions.GetData();
+    for (const FSoftBodySectionRange& Range : UploadRanges)
+    {
+        ParallelFor(Range.NumVertices, [this, &Range, &Layout, Positions, bDirtyOnly](int32 LocalIdx)
+        {
+            const int32 VertexIdx = Range.FirstVertex + LocalIdx;
+            if (bDirtyOnly && !IsTangentFrameDirty(Layout, VertexIdx))
+            {
+                return;
+            }
+
+            FVector3f Normal = FVector3f::ZeroVector;
+            for (int32 Adjacent = VertexTriangleOffsets[VertexIdx]; Adjacent < VertexTriangleOffsets[VertexIdx + 1]; Adjacent++)
+            {
+                const int32 Triangle = VertexTriangles[Adjacent];
+                const FVector3f& P0 = Positions[Indices[Triangle * 3]];
+                const FVector3f& P1 = Positions[Indices[Triangle * 3 + 1]];
+                const FVector3f& P2 = Positions[Indices[Triangle * 3 + 2]];
+                Normal += (P1 - P0) ^ (P2 - P0);
+            }
+
+            const FVector4f& RestZ = RestTangentZ[VertexIdx];
+            const FVector3f RestNormal(RestZ);
+            Normal = (Normal * FaceNormalSign).GetSafeNormal(UE_SMALL_NUMBER, RestNormal);
+
+            // Carry the rest tangent along with the normal's rotation, then re-orthogonalize
+            FVector3f Tangent = FQuat4f::FindBetweenNormals(RestNormal, Normal).RotateVector(RestTangentX[VertexIdx]);
+            Tangent = (Tangent - Normal * FVector3f::DotProduct(Normal, Tangent)).GetSafeNormal(UE_SMALL_NUMBER, RestTangentX[VertexIdx]);
+
+            if (bUseHighPrecisionTangents)
+            {
+                FPackedRGBA16N* Tangents = reinterpret_cast<FPackedRGBA16N*>(PackedTangents.GetData()) + VertexIdx * 2;
+                Tangents[0] = FPackedRGBA16N(FVector4f(Tangent, 0.0f));
+                Tangents[1] = FPackedRGBA16N(FVector4f(Normal, RestZ.W));
+            }
+            else
+            {
+                FPackedNormal* Tangents = reinterpret_cast<FPackedNormal*>(PackedTangents.GetData()) + VertexIdx * 2;
+                Tangents[0] = FPackedNormal(FVector4f(Tangent, 0.0f));
+                Tangents[1] = FPackedNormal(FVector4f(Normal, RestZ.W));
+            }
+        });
+    }
+
+    bTangentsInitialized = true;
+    return true;
+}
+
 void UVertexBufferUpdater::ApplyPositions(UPBDSoftBodyComponent* Component)
 {
     if (!Component || Component->SimulatedPositions.Num() == 0)
     {
-        if (Component && Component->bEnableDebugLogging && Component->GetOwner())
+        if (Component && Component->bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: ApplyPositions - No simulated positions for %s."), *Component->GetOwner()->GetName());
+            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: ApplyPositions - No simulated positions for %s."), *GetNameSafe(Component->GetOwner()));
         }
         return;
     }
@@ -18,13 +265,13 @@ void UVertexBufferUpdater::ApplyPositions(UPBDSoftBodyComponent* Component)
     {
         if (Component->bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Failed to get skeletal mesh or rendering resource for %s."), *Component->GetOwner()->GetName());
+            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Failed to get skeletal mesh or rendering resource for %s."), *GetNameSafe(Component->GetOwner()));
         }
         return;
     }
 
-    FSkeletalMeshLODRenderData* LODRenderData = Mesh->GetResourceForRendering()->LODRenderData.IsValidIndex(0)
-        ? &Mesh->GetResourceForRendering()->LODRenderData[0]
+    FSkeletalMeshLODRenderData* LODRenderData = Mesh->GetResourceForRendering()->LODRenderData.IsValidIndex(UPBDSoftBodyComponent::SimulationLODIndex)
+        ? &Mesh->GetResourceForRendering()->LODRenderData[UPBDSoftBodyComponent::SimulationLODIndex]
         : nullptr;
     if (!LODRenderData)
     {
@@ -36,53 +283,102 @@ void UVertexBufferUpdater::ApplyPositions(UPBDSoftBodyComponent* Component)
     }
 
     FPositionVertexBuffer& PositionBuffer = LODRenderData->StaticVertexBuffers.PositionVertexBuffer;
-    if (PositionBuffer.GetNumVertices() != Component->SimulatedPositions.Num())
+    if (static_cast<int32>(PositionBuffer.GetNumVertices()) != Component->ParticleLayout.RenderToParticle.Num())
     {
         if (Component->bEnableDebugLogging)
         {
-            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Vertex count mismatch when applying positions. Buffer: %d, Simulated: %d."),
-                PositionBuffer.GetNumVertices(), Component->SimulatedPositions.Num());
+            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Vertex count mismatch when applying positions. Buffer: %d, Layout: %d."),
+                PositionBuffer.GetNumVertices(), Component->ParticleLayout.RenderToParticle.Num());
         }
         return;
     }
 
+    if (!PackPositions(Component))
+    {
+        if (Component->bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Nothing to upload for %s."), *GetNameSafe(Component->GetOwner()));
+        }
+        return;
+    }
+
+    bUploadTangents = Component->bRecomputeTangents && RecomputeTangents(Component);
+
+    FStaticMeshVertexBuffer& TangentBuffer = LODRenderData->StaticVertexBuffers.StaticMeshVertexBuffer;
+    const uint32 TangentStride = 2 * (bUseHighPrecisionTangents ? sizeof(FPackedRGBA16N) : sizeof(FPackedNormal));
+    const uint8* Tangents = bUploadTangents ? PackedTangents.GetData() : nullptr;
+
+    const bool bLogFailures = Component->bEnableDebugLogging;
+    const FString OwnerName = GetNameSafe(Component->GetOwner());
     ENQUEUE_RENDER_COMMAND(UpdateSoftBodyPositions)(
-        [Component, &PositionBuffer](FRHICommandListImmediate& RHICmdList)
+        [&PositionBuffer, &TangentBuffer, Packed = PackedPositions.GetData(), Tangents, TangentStride, Ranges = UploadRanges, bLogFailures, OwnerName](FRHICommandListImmediate& RHICmdList)
         {
             FBufferRHIRef& VertexBuffer = PositionBuffer.VertexBufferRHI;
             if (!VertexBuffer.IsValid())
             {
-                if (Component->bEnableDebugLogging)
+                if (bLogFailures)
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Vertex buffer not valid for %s."), *Component->GetOwner()->GetName());
+                    UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Vertex buffer not valid for %s."), *OwnerName);
                 }
                 return;
             }
 
-            void* VertexData = RHICmdList.LockBuffer(VertexBuffer.GetReference(), 0, PositionBuffer.GetNumVertices() * sizeof(FVector3f), RLM_WriteOnly);
-            if (VertexData)
+            for (const FSoftBodySectionRange& Range : Ranges)
             {
-                FVector3f* Positions = static_cast<FVector3f*>(VertexData);
-                for (int32 i = 0; i < Component->SimulatedPositions.Num(); i++)
+                const uint32 RangeBytes = Range.NumVertices * sizeof(FVector3f);
+                void* VertexData = RHICmdList.LockBuffer(VertexBuffer.GetReference(), Range.FirstVertex * sizeof(FVector3f), RangeBytes, RLM_WriteOnly);
+                if (!VertexData)
                 {
-                    Positions[i] = FVector3f(Component->SimulatedPositions[i].X, Component->SimulatedPositions[i].Y, Component->SimulatedPositions[i].Z);
+                    if (bLogFailures)
+                    {
+                        UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Failed to lock vertex buffer section %d for %s."), Range.SectionIndex, *OwnerName);
+                    }
+                    continue;
                 }
+                FMemory::Memcpy(VertexData, Packed + Range.FirstVertex, RangeBytes);
                 RHICmdList.UnlockBuffer(VertexBuffer.GetReference());
+            }
 
-                if (Component->bEnableDebugLogging && !Component->bHasLoggedBlending && Component->GetSkeletalMeshAsset()->GetName().Contains(TEXT("SKM_Quinn")))
-                {
-                    UE_LOG(LogTemp, Log, TEXT("VertexBufferUpdater: Successfully applied %d simulated positions to SKM_Quinn."), Component->SimulatedPositions.Num());
-                    Component->bHasLoggedBlending = true;
-                }
+            FBufferRHIRef& TangentsRHI = TangentBuffer.TangentsVertexBuffer.VertexBufferRHI;
+            if (!Tangents || !TangentsRHI.IsValid())
+            {
+                return;
             }
-            else
+            for (const FSoftBodySectionRange& Range : Ranges)
             {
-                if (Component->bEnableDebugLogging)
+                const uint32 RangeBytes = Range.NumVertices * TangentStride;
+                void* TangentData = RHICmdList.LockBuffer(TangentsRHI.GetReference(), Range.FirstVertex * TangentStride, RangeBytes, RLM_WriteOnly);
+                if (!TangentData)
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Failed to lock vertex buffer for %s."), *Component->GetOwner()->GetName());
+                    if (bLogFailures)
+                    {
+                        UE_LOG(LogTemp, Warning, TEXT("VertexBufferUpdater: Failed to lock tangent buffer section %d for %s."), Range.SectionIndex, *OwnerName);
+                    }
+                    continue;
                 }
+                FMemory::Memcpy(TangentData, Tangents + Range.FirstVertex * TangentStride, RangeBytes);
+                RHICmdList.UnlockBuffer(TangentsRHI.GetReference());
             }
         });
+    UploadFence.BeginFence();
+
+    if (Component->bEnableDebugLogging && !Component->bHasLoggedBlending && Mesh->GetName().Contains(TEXT("SKM_Quinn")))
+    {
+        UE_LOG(LogTemp, Log, TEXT("VertexBufferUpdater: Successfully applied %d simulated positions to SKM_Quinn."), UploadVertexCount);
+        Component->bHasLoggedBlending = true;
+    }
 
+    Component->SimulationStats.UploadedVertices = UploadVertexCount;
     Component->MarkRenderStateDirty();
-}
\ No newline at end of file
+}
+SIZE_T UVertexBufferUpdater::GetTopologyAllocatedSize() const
+{
+    return Indices.GetAllocatedSize() + VertexTriangleOffsets.GetAllocatedSize() + VertexTriangles.GetAllocatedSize()
+        + RestTangentX.GetAllocatedSize() + RestTangentZ.GetAllocatedSize();
+}
+
+SIZE_T UVertexBufferUpdater::GetAllocatedSize() const
+{
+    return GetTopologyAllocatedSize() + PackedPositions.GetAllocatedSize() + UploadRanges.GetAllocatedSize()
+        + PackedTangents.GetAllocatedSize() + DirtyParticles.GetAllocatedSize();
+}
@@ -2,14 +2,58 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "RenderCommandFence.h"
 #include "PBDSoftBodyComponent.h"
 #include "VertexBufferUpdater.generated.h"
 
+class FSkeletalMeshLODRenderData;
+
 UCLASS()
 class PBDSOFTBODYPLUGIN_API UVertexBufferUpdater : public UObject
 {
     GENERATED_BODY()
 
 public:
+    virtual void BeginDestroy() override;
+    virtual bool IsReadyForFinishDestroy() override;
+
     void ApplyPositions(UPBDSoftBodyComponent* Component);
+
+    // Fans particle positions back out into render vertex order; the only place the particle layout is applied
+    bool PackPositions(const UPBDSoftBodyComponent* Component);
+
+    // Precomputes vertex-triangle adjacency (CSR) and rest tangent frames for the uploaded sections
+    void BuildTangentData(const UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData);
+
+    // Rebuilds packed normals/tangents from PackedPositions; call after PackPositions
+    bool RecomputeTangents(const UPBDSoftBodyComponent* Component);
+
+    // Heap bytes held; the topology part (indices, adjacency, rest tangents) depends only on the mesh, the rest is upload staging
+    SIZE_T GetAllocatedSize() const;
+    SIZE_T GetTopologyAllocatedSize() const;
+
+private:
+    // True if the vertex's particle or any corner of its adjacent triangles is in DirtyParticles
+    bool IsTangentFrameDirty(const FSoftBodyParticleLayout& Layout, int32 VertexIdx) const;
+
+    // Render-ordered staging read by the render thread; only rewritten once UploadFence has passed
+    TArray<FVector3f> PackedPositions;
+    TArray<FSoftBodySectionRange> UploadRanges;
+    int32 UploadVertexCount = 0;
+    FRenderCommandFence UploadFence;
+
+    // Vertex-triangle adjacency: triangles of vertex V are VertexTriangles[VertexTriangleOffsets[V] .. VertexTriangleOffsets[V + 1])
+    TArray<uint32> Indices;
+    TArray<int32> VertexTriangleOffsets;
+    TArray<int32> VertexTriangles;
+    TArray<FVector3f> RestTangentX;
+    TArray<FVector4f> RestTangentZ;
+    float FaceNormalSign = 1.0f;
+
+    // Render-ordered TangentX/TangentZ pairs in the mesh's tangent format
+    TArray<uint8> PackedTangents;
+    TArray<uint8> DirtyParticles;
+    bool bUseHighPrecisionTangents = false;
+    bool bTangentsInitialized = false;
+    bool bUploadTangents = false;
 };
\ No newline at end of file
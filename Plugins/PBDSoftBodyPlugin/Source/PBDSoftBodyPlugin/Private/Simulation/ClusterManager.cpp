@@ -1,9 +1,115 @@
 #include "PBDSoftBodyPlugin/Private/Simulation/ClusterManager.h"
+#include "Rendering/SkeletalMeshRenderData.h"
 #include "SoftBodyCluster.h"
 
-void UClusterManager::GenerateClusters(UPBDSoftBodyComponent* Component, const TArray<FVector>& VertexPositions)
+void UClusterManager::BuildSectionRanges(UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData)
 {
-    if (!Component || VertexPositions.Num() == 0 || Component->NumClusters <= 0)
+    if (!Component)
+    {
+        return;
+    }
+
+    Component->SectionRanges.Reset(LODRenderData.RenderSections.Num());
+    for (int32 SectionIdx = 0; SectionIdx < LODRenderData.RenderSections.Num(); SectionIdx++)
+    {
+        const FSkelMeshRenderSection& Section = LODRenderData.RenderSections[SectionIdx];
+
+        FSoftBodySectionRange& Range = Component->SectionRanges.AddDefaulted_GetRef();
+        Range.SectionIndex = SectionIdx;
+        Range.FirstVertex = Section.BaseVertexIndex;
+        Range.NumVertices = Section.NumVertices;
+        Range.Mode = Section.bDisabled ? ESoftBodySectionMode::Excluded : Component->GetSectionMode(SectionIdx);
+
+        if (Component->bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Log, TEXT("ClusterManager: Section %d (material %d) covers vertices [%d, %d) as %s."),
+                SectionIdx, Section.MaterialIndex, Range.FirstVertex, Range.FirstVertex + Range.NumVertices,
+                *StaticEnum<ESoftBodySectionMode>()->GetNameStringByValue(static_cast<int64>(Range.Mode)));
+        }
+    }
+}
+
+void UClusterManager::BuildWeldMap(const UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData, FSoftBodyWeldMap& OutWeldMap) const
+{
+    const FPositionVertexBuffer& PositionBuffer = LODRenderData.StaticVertexBuffers.PositionVertexBuffer;
+    const int32 NumRenderVertices = PositionBuffer.GetNumVertices();
+
+    OutWeldMap.UniqueVertices.Reset(NumRenderVertices);
+    OutWeldMap.SectionOffsets.Reset(Component->SectionRanges.Num() + 1);
+    OutWeldMap.RenderToUnique.Init(INDEX_NONE, NumRenderVertices);
+
+    const float Tolerance = FMath::Max(Component->WeldTolerance, KINDA_SMALL_NUMBER);
+    const float ToleranceSq = FMath::Square(Tolerance);
+
+    // Welding spans sections, so seams between sections (e.g. material boundaries) share particles too. Only sections of
+    // the same mode weld: a simulated vertex never follows a rigid particle or the other way round. A vertex welded into
+    // an earlier section's particle adds none to its own section, so particle ranges stay contiguous per section.
+    TMultiMap<FIntVector, int32> SimulatedCells;
+    TMultiMap<FIntVector, int32> RigidCells;
+
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        OutWeldMap.SectionOffsets.Add(OutWeldMap.UniqueVertices.Num());
+        if (Range.Mode == ESoftBodySectionMode::Excluded || Range.FirstVertex + Range.NumVertices > NumRenderVertices)
+        {
+            continue;
+        }
+
+        TMultiMap<FIntVector, int32>& Cells = Range.Mode == ESoftBodySectionMode::Rigid ? RigidCells : SimulatedCells;
+        int32 NumWeldedAcross = 0;
+        for (int32 VertexIdx = Range.FirstVertex; VertexIdx < Range.FirstVertex + Range.NumVertices; VertexIdx++)
+        {
+            const FVector3f& Position = PositionBuffer.VertexPosition(VertexIdx);
+            int32 UniqueIdx = INDEX_NONE;
+
+            if (Component->bWeldVertices)
+            {
+                const FIntVector Cell(FMath::FloorToInt(Position.X / Tolerance), FMath::FloorToInt(Position.Y / Tolerance), FMath::FloorToInt(Position.Z / Tolerance));
+                for (int32 X = -1; X <= 1 && UniqueIdx == INDEX_NONE; X++)
+                {
+                    for (int32 Y = -1; Y <= 1 && UniqueIdx == INDEX_NONE; Y++)
+                    {
+                        for (int32 Z = -1; Z <= 1 && UniqueIdx == INDEX_NONE; Z++)
+                        {
+                            for (auto It = Cells.CreateConstKeyIterator(Cell + FIntVector(X, Y, Z)); It; ++It)
+                            {
+                                if (FVector3f::DistSquared(PositionBuffer.VertexPosition(OutWeldMap.UniqueVertices[It.Value()]), Position) <= ToleranceSq)
+                                {
+                                    UniqueIdx = It.Value();
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+                if (UniqueIdx == INDEX_NONE)
+                {
+                    UniqueIdx = OutWeldMap.UniqueVertices.Add(VertexIdx);
+                    Cells.Add(Cell, UniqueIdx);
+                }
+            }
+            else
+            {
+                UniqueIdx = OutWeldMap.UniqueVertices.Add(VertexIdx);
+            }
+
+            OutWeldMap.RenderToUnique[VertexIdx] = UniqueIdx;
+            NumWeldedAcross += UniqueIdx < OutWeldMap.SectionOffsets.Last() ? 1 : 0;
+        }
+
+        if (Component->bVerboseDebugLogging)
+        {
+            UE_LOG(LogTemp, Log, TEXT("ClusterManager: Section %d welded %d render vertices into %d particles, %d of them shared with earlier sections."),
+                Range.SectionIndex, Range.NumVertices, OutWeldMap.UniqueVertices.Num() - OutWeldMap.SectionOffsets.Last(), NumWeldedAcross);
+        }
+    }
+    OutWeldMap.SectionOffsets.Add(OutWeldMap.UniqueVertices.Num());
+}
+
+void UClusterManager::GenerateClusters(UPBDSoftBodyComponent* Component, const TArray<FVector>& VertexPositions, const FSoftBodyWeldMap& WeldMap)
+{
+    if (!Component || VertexPositions.Num() == 0 || Component->NumClusters <= 0
+        || WeldMap.SectionOffsets.Num() != Component->SectionRanges.Num() + 1)
     {
         if (Component && Component->bEnableDebugLogging)
         {
@@ -13,62 +119,223 @@ void UClusterManager::GenerateClusters(UPBDSoftBodyComponent* Component, const T
         return;
     }
 
-    int32 VerticesPerCluster = VertexPositions.Num() / Component->NumClusters;
-    Component->Clusters.SetNum(Component->NumClusters, EAllowShrinking::No);
-
-    if (Component->bVerboseDebugLogging)
+    int32 SimulatedParticleCount = 0;
+    for (int32 RangeIdx = 0; RangeIdx < Component->SectionRanges.Num(); RangeIdx++)
     {
-        UE_LOG(LogTemp, Log, TEXT("ClusterManager: Generating %d clusters with ~%d vertices each."),
-            Component->NumClusters, VerticesPerCluster);
+        if (Component->SectionRanges[RangeIdx].Mode == ESoftBodySectionMode::Simulated)
+        {
+            SimulatedParticleCount += WeldMap.SectionOffsets[RangeIdx + 1] - WeldMap.SectionOffsets[RangeIdx];
+        }
     }
 
-    for (int32 ClusterIdx = 0; ClusterIdx < Component->NumClusters; ClusterIdx++)
+    Component->Clusters.Reset();
+    if (SimulatedParticleCount == 0)
     {
-        FSoftBodyCluster& Cluster = Component->Clusters[ClusterIdx];
-        Cluster.VertexIndices.Reset();
-        Cluster.VertexOffsets.Reset();
+        if (Component->bEnableDebugLogging)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ClusterManager: GenerateClusters - No simulated sections."));
+        }
+        return;
+    }
 
-        int32 StartIdx = ClusterIdx * VerticesPerCluster;
-        int32 EndIdx = (ClusterIdx == Component->NumClusters - 1) ? VertexPositions.Num() : (ClusterIdx + 1) * VerticesPerCluster;
+    if (Component->bVerboseDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ClusterManager: Generating ~%d clusters over %d welded particles in %d sections."),
+            Component->NumClusters, SimulatedParticleCount, Component->SectionRanges.Num());
+    }
 
-        for (int32 i = StartIdx; i < EndIdx; i++)
+    // Clusters never straddle a section: each simulated section gets its share of NumClusters
+    for (int32 RangeIdx = 0; RangeIdx < Component->SectionRanges.Num(); RangeIdx++)
+    {
+        const FSoftBodySectionRange& Range = Component->SectionRanges[RangeIdx];
+        const int32 SectionStart = WeldMap.SectionOffsets[RangeIdx];
+        const int32 SectionCount = WeldMap.SectionOffsets[RangeIdx + 1] - SectionStart;
+        if (Range.Mode != ESoftBodySectionMode::Simulated || SectionCount <= 0)
         {
-            Cluster.VertexIndices.Add(i);
+            continue;
         }
 
-        FVector Centroid = FVector::ZeroVector;
-        for (int32 VertexIdx : Cluster.VertexIndices)
+        const int32 SectionClusters = FMath::Clamp(
+            FMath::RoundToInt(static_cast<float>(Component->NumClusters) * SectionCount / SimulatedParticleCount), 1, SectionCount);
+        const int32 ParticlesPerCluster = SectionCount / SectionClusters;
+
+        for (int32 LocalClusterIdx = 0; LocalClusterIdx < SectionClusters; LocalClusterIdx++)
         {
-            Centroid += VertexPositions[VertexIdx];
+            const int32 ClusterIdx = Component->Clusters.Num();
+            FSoftBodyCluster& Cluster = Component->Clusters.AddDefaulted_GetRef();
+            Cluster.SectionIndex = Range.SectionIndex;
+
+            int32 StartIdx = SectionStart + LocalClusterIdx * ParticlesPerCluster;
+            int32 EndIdx = (LocalClusterIdx == SectionClusters - 1) ? SectionStart + SectionCount : StartIdx + ParticlesPerCluster;
+
+            Cluster.VertexIndices.Reserve(EndIdx - StartIdx);
+            for (int32 i = StartIdx; i < EndIdx; i++)
+            {
+                Cluster.VertexIndices.Add(WeldMap.UniqueVertices[i]);
+            }
+
+            FVector Centroid = FVector::ZeroVector;
+            for (int32 VertexIdx : Cluster.VertexIndices)
+            {
+                Centroid += VertexPositions[VertexIdx];
+            }
+            if (Cluster.VertexIndices.Num() > 0)
+            {
+                Centroid /= Cluster.VertexIndices.Num();
+            }
+            else
+            {
+                if (Component->bEnableDebugLogging)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("ClusterManager: Cluster %d has no vertices assigned."), ClusterIdx);
+                }
+            }
+            Cluster.CentroidPosition = Centroid;
+            Cluster.CentroidVelocity = FVector::ZeroVector;
+
+            Cluster.VertexOffsets.SetNum(Cluster.VertexIndices.Num(), EAllowShrinking::No);
+            for (int32 i = 0; i < Cluster.VertexIndices.Num(); i++)
+            {
+                Cluster.VertexOffsets[i] = VertexPositions[Cluster.VertexIndices[i]] - Centroid;
+            }
+
+            if (Component->bEnableDebugLogging)
+            {
+                UE_LOG(LogTemp, Log, TEXT("ClusterManager: Cluster %d (section %d) created with %d particles."), ClusterIdx, Range.SectionIndex, Cluster.VertexIndices.Num());
+            }
+            if (Component->bVerboseDebugLogging)
+            {
+                UE_LOG(LogTemp, Log, TEXT("ClusterManager: Cluster %d centroid at (%.2f, %.2f, %.2f)."),
+                    ClusterIdx, Centroid.X, Centroid.Y, Centroid.Z);
+            }
         }
-        if (Cluster.VertexIndices.Num() > 0)
+    }
+}
+
+void UClusterManager::BuildParticleLayout(UPBDSoftBodyComponent* Component, const FSoftBodyWeldMap& WeldMap)
+{
+    if (!Component || WeldMap.SectionOffsets.Num() != Component->SectionRanges.Num() + 1)
+    {
+        return;
+    }
+
+    const int32 NumRenderVertices = WeldMap.RenderToUnique.Num();
+    FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+    Layout.Reset();
+    Layout.ParticleToRenderVertex.Reserve(WeldMap.UniqueVertices.Num());
+
+    TArray<int32> RenderToParticle;
+    RenderToParticle.Init(INDEX_NONE, NumRenderVertices);
+
+    // Clusters are generated section by section, so a single cursor walks them in step with the sections
+    int32 ClusterCursor = 0;
+    for (int32 RangeIdx = 0; RangeIdx < Component->SectionRanges.Num(); RangeIdx++)
+    {
+        FSoftBodySectionRange& Range = Component->SectionRanges[RangeIdx];
+        Range.FirstParticle = Layout.ParticleToRenderVertex.Num();
+
+        if (Range.Mode == ESoftBodySectionMode::Simulated)
         {
-            Centroid /= Cluster.VertexIndices.Num();
+            while (Component->Clusters.IsValidIndex(ClusterCursor) && Component->Clusters[ClusterCursor].SectionIndex == Range.SectionIndex)
+            {
+                FSoftBodyCluster& Cluster = Component->Clusters[ClusterCursor++];
+                Cluster.ParticleStart = Layout.ParticleToRenderVertex.Num();
+                Cluster.ParticleCount = Cluster.VertexIndices.Num();
+                for (int32 VertexIdx : Cluster.VertexIndices)
+                {
+                    RenderToParticle[VertexIdx] = Layout.ParticleToRenderVertex.Add(VertexIdx);
+                }
+                Cluster.VertexIndices.Empty();
+            }
         }
-        else
+        else if (Range.Mode == ESoftBodySectionMode::Rigid)
         {
-            if (Component->bEnableDebugLogging)
+            for (int32 UniqueIdx = WeldMap.SectionOffsets[RangeIdx]; UniqueIdx < WeldMap.SectionOffsets[RangeIdx + 1]; UniqueIdx++)
             {
-                UE_LOG(LogTemp, Warning, TEXT("ClusterManager: Cluster %d has no vertices assigned."), ClusterIdx);
+                const int32 VertexIdx = WeldMap.UniqueVertices[UniqueIdx];
+                RenderToParticle[VertexIdx] = Layout.ParticleToRenderVertex.Add(VertexIdx);
             }
         }
-        Cluster.CentroidPosition = Centroid;
-        Cluster.CentroidVelocity = FVector::ZeroVector;
 
-        Cluster.VertexOffsets.SetNum(Cluster.VertexIndices.Num(), EAllowShrinking::No);
-        for (int32 i = 0; i < Cluster.VertexIndices.Num(); i++)
+        Range.NumParticles = Layout.ParticleToRenderVertex.Num() - Range.FirstParticle;
+    }
+
+    // Fan out: every welded duplicate packs from its representative's particle
+    Layout.RenderToParticle.Init(INDEX_NONE, NumRenderVertices);
+    for (int32 VertexIdx = 0; VertexIdx < NumRenderVertices; VertexIdx++)
+    {
+        const int32 UniqueIdx = WeldMap.RenderToUnique[VertexIdx];
+        if (UniqueIdx != INDEX_NONE)
         {
-            Cluster.VertexOffsets[i] = VertexPositions[Cluster.VertexIndices[i]] - Centroid;
+            Layout.RenderToParticle[VertexIdx] = RenderToParticle[WeldMap.UniqueVertices[UniqueIdx]];
         }
+    }
 
-        if (Component->bEnableDebugLogging)
+    Layout.LayoutHash = FCrc::MemCrc32(Layout.ParticleToRenderVertex.GetData(), Layout.ParticleToRenderVertex.Num() * sizeof(int32));
+
+    if (Component->bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ClusterManager: Particle layout built with %d particles for %d render vertices across %d clusters."),
+            Layout.GetNumParticles(), NumRenderVertices, Component->Clusters.Num());
+    }
+}
+
+void UClusterManager::BuildClusterHierarchy(const UPBDSoftBodyComponent* Component, int32 NumCoarseLevels, int32 ClustersPerSuperCluster,
+    TArray<TArray<FSoftBodyClusterNode>>& OutLevels) const
+{
+    OutLevels.Reset();
+    if (!Component || NumCoarseLevels <= 0 || Component->Clusters.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FSoftBodyClusterNode>& ClusterLevel = OutLevels.AddDefaulted_GetRef();
+    for (const FSoftBodyCluster& Cluster : Component->Clusters)
+    {
+        ClusterLevel.Add({ Cluster.ParticleStart, Cluster.ParticleCount });
+    }
+
+    const int32 GroupSize = FMath::Max(ClustersPerSuperCluster, 2);
+    for (int32 LevelIdx = 1; LevelIdx < NumCoarseLevels; LevelIdx++)
+    {
+        // Merge runs of consecutive nodes, never across a section boundary
+        const TArray<FSoftBodyClusterNode>& Finer = OutLevels[LevelIdx - 1];
+        TArray<FSoftBodyClusterNode> Coarser;
+        int32 SectionCursor = 0;
+        for (int32 NodeIdx = 0; NodeIdx < Finer.Num();)
+        {
+            const FSoftBodyClusterNode& First = Finer[NodeIdx];
+            while (Component->SectionRanges.IsValidIndex(SectionCursor)
+                && First.ParticleStart >= Component->SectionRanges[SectionCursor].FirstParticle + Component->SectionRanges[SectionCursor].NumParticles)
+            {
+                SectionCursor++;
+            }
+            const int32 SectionEnd = Component->SectionRanges.IsValidIndex(SectionCursor)
+                ? Component->SectionRanges[SectionCursor].FirstParticle + Component->SectionRanges[SectionCursor].NumParticles
+                : MAX_int32;
+
+            FSoftBodyClusterNode Merged = First;
+            int32 Grouped = 1;
+            for (NodeIdx++; NodeIdx < Finer.Num() && Grouped < GroupSize && Finer[NodeIdx].ParticleStart < SectionEnd; NodeIdx++, Grouped++)
+            {
+                Merged.ParticleCount = Finer[NodeIdx].ParticleStart + Finer[NodeIdx].ParticleCount - Merged.ParticleStart;
+            }
+            Coarser.Add(Merged);
+        }
+
+        // No further reduction possible; stop rather than add an identical level
+        if (Coarser.Num() == Finer.Num())
         {
-            UE_LOG(LogTemp, Log, TEXT("ClusterManager: Cluster %d created with %d vertices."), ClusterIdx, Cluster.VertexIndices.Num());
+            break;
         }
-        if (Component->bVerboseDebugLogging)
+        OutLevels.Add(MoveTemp(Coarser));
+    }
+
+    if (Component->bEnableDebugLogging)
+    {
+        for (int32 LevelIdx = 0; LevelIdx < OutLevels.Num(); LevelIdx++)
         {
-            UE_LOG(LogTemp, Log, TEXT("ClusterManager: Cluster %d centroid at (%.2f, %.2f, %.2f)."),
-                ClusterIdx, Centroid.X, Centroid.Y, Centroid.Z);
+            UE_LOG(LogTemp, Log, TEXT("ClusterManager: Solver level %d has %d nodes."), LevelIdx + 1, OutLevels[LevelIdx].Num());
         }
     }
-}
\ No newline at end of file
+}
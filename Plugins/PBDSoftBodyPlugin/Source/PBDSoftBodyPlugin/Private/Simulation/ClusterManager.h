@@ -5,11 +5,42 @@
 #include "PBDSoftBodyComponent.h"
 #include "ClusterManager.generated.h"
 
+class FSkeletalMeshLODRenderData;
+
+// Unique particles of each section after welding coincident render vertices (UV seams, hard normals)
+struct FSoftBodyWeldMap
+{
+    // Representative render vertex per unique particle, grouped by section in SectionRanges order
+    TArray<int32> UniqueVertices;
+
+    // Start of each section's representatives in UniqueVertices, with a trailing end entry
+    TArray<int32> SectionOffsets;
+
+    // Unique particle for each render vertex; INDEX_NONE for excluded sections. A vertex on a seam between sections of
+    // the same mode maps to the particle of the first section it occurs in.
+    TArray<int32> RenderToUnique;
+};
+
+// Contiguous particle range aggregated into one node of a coarse solver level
+struct FSoftBodyClusterNode
+{
+    int32 ParticleStart = 0;
+    int32 ParticleCount = 0;
+};
+
 UCLASS()
 class PBDSOFTBODYPLUGIN_API UClusterManager : public UObject
 {
     GENERATED_BODY()
 
 public:
-    void GenerateClusters(UPBDSoftBodyComponent* Component, const TArray<FVector>& VertexPositions);
+    void BuildSectionRanges(UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData);
+    void BuildWeldMap(const UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData, FSoftBodyWeldMap& OutWeldMap) const;
+    void GenerateClusters(UPBDSoftBodyComponent* Component, const TArray<FVector>& VertexPositions, const FSoftBodyWeldMap& WeldMap);
+    void BuildParticleLayout(UPBDSoftBodyComponent* Component, const FSoftBodyWeldMap& WeldMap);
+
+    // Coarse solver levels, finest first: the clusters themselves, then super-clusters of up to ClustersPerSuperCluster
+    // consecutive clusters of the same section. Every node is a contiguous particle range because clusters are.
+    void BuildClusterHierarchy(const UPBDSoftBodyComponent* Component, int32 NumCoarseLevels, int32 ClustersPerSuperCluster,
+        TArray<TArray<FSoftBodyClusterNode>>& OutLevels) const;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "SoftBodySnapshot.h"
+#include "PBDSoftBodyComponent.h"
+
+bool FSoftBodySnapshot::Save(const UPBDSoftBodyComponent& Component, TArray<uint8>& OutData)
+{
+    const int32 NumParticles = Component.SimulatedPositions.Num();
+    if (NumParticles == 0 || Component.Velocities.Num() != NumParticles || !Component.ParticleLayout.IsValid())
+    {
+        return false;
+    }
+
+    FSoftBodySnapshotHeader Header;
+    Header.NumParticles = NumParticles;
+    Header.NumClusters = Component.Clusters.Num();
+    Header.LayoutHash = Component.ParticleLayout.LayoutHash;
+
+    const SIZE_T ParticleBytes = NumParticles * sizeof(FVector);
+    OutData.SetNumUninitialized(sizeof(Header) + 2 * ParticleBytes + Header.NumClusters * sizeof(FSoftBodyClusterState));
+    uint8* Cursor = OutData.GetData();
+
+    FMemory::Memcpy(Cursor, &Header, sizeof(Header));
+    Cursor += sizeof(Header);
+    FMemory::Memcpy(Cursor, Component.SimulatedPositions.GetData(), ParticleBytes);
+    Cursor += ParticleBytes;
+    FMemory::Memcpy(Cursor, Component.Velocities.GetData(), ParticleBytes);
+    Cursor += ParticleBytes;
+
+    FSoftBodyClusterState* ClusterStates = reinterpret_cast<FSoftBodyClusterState*>(Cursor);
+    for (const FSoftBodyCluster& Cluster : Component.Clusters)
+    {
+        FSoftBodyClusterState& State = *ClusterStates++;
+        State.CentroidPosition = Cluster.CentroidPosition;
+        State.CentroidVelocity = Cluster.CentroidVelocity;
+        State.LastAnimatedCentroid = Cluster.LastAnimatedCentroid;
+        State.SleepAnimatedCentroid = Cluster.SleepAnimatedCentroid;
+        State.StillFrameCount = Cluster.StillFrameCount;
+        State.bIsSleeping = Cluster.bIsSleeping ? 1 : 0;
+    }
+    return true;
+}
+
+bool FSoftBodySnapshot::Restore(UPBDSoftBodyComponent& Component, const TArray<uint8>& Data)
+{
+    if (Data.Num() < static_cast<int32>(sizeof(FSoftBodySnapshotHeader)))
+    {
+        return false;
+    }
+
+    FSoftBodySnapshotHeader Header;
+    FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+    if (Header.Magic != FSoftBodySnapshotHeader::SnapshotMagic || Header.Version != FSoftBodySnapshotHeader::SnapshotVersion)
+    {
+        return false;
+    }
+
+    const SIZE_T ParticleBytes = Header.NumParticles * sizeof(FVector);
+    const SIZE_T ExpectedBytes = sizeof(Header) + 2 * ParticleBytes + Header.NumClusters * sizeof(FSoftBodyClusterState) + Header.NumSolverValues * sizeof(float);
+    if (static_cast<SIZE_T>(Data.Num()) != ExpectedBytes
+        || Header.NumParticles != Component.ParticleLayout.GetNumParticles()
+        || Header.NumClusters != Component.Clusters.Num()
+        || Header.LayoutHash != Component.ParticleLayout.LayoutHash)
+    {
+        return false;
+    }
+
+    const uint8* Cursor = Data.GetData() + sizeof(Header);
+    Component.SimulatedPositions.SetNumUninitialized(Header.NumParticles, EAllowShrinking::No);
+    FMemory::Memcpy(Component.SimulatedPositions.GetData(), Cursor, ParticleBytes);
+    Cursor += ParticleBytes;
+    Component.Velocities.SetNumUninitialized(Header.NumParticles, EAllowShrinking::No);
+    FMemory::Memcpy(Component.Velocities.GetData(), Cursor, ParticleBytes);
+    Cursor += ParticleBytes;
+
+    const FSoftBodyClusterState* ClusterStates = reinterpret_cast<const FSoftBodyClusterState*>(Cursor);
+    for (FSoftBodyCluster& Cluster : Component.Clusters)
+    {
+        const FSoftBodyClusterState& State = *ClusterStates++;
+        Cluster.CentroidPosition = State.CentroidPosition;
+        Cluster.CentroidVelocity = State.CentroidVelocity;
+        Cluster.LastAnimatedCentroid = State.LastAnimatedCentroid;
+        Cluster.SleepAnimatedCentroid = State.SleepAnimatedCentroid;
+        Cluster.StillFrameCount = State.StillFrameCount;
+        Cluster.bIsSleeping = State.bIsSleeping != 0;
+        Cluster.bUpdatedThisFrame = true;
+    }
+    return true;
+}
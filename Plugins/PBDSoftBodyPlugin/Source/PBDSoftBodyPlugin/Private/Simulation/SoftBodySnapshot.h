@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPBDSoftBodyComponent;
+
+// Binary layout (native endianness):
+//   FSoftBodySnapshotHeader
+//   FVector SimulatedPositions[NumParticles]
+//   FVector Velocities[NumParticles]
+//   FSoftBodyClusterState[NumClusters]
+//   float SolverValues[NumSolverValues]
+// Per-particle arrays are copied as single blocks, so a restore is a handful of memcpys.
+struct FSoftBodySnapshotHeader
+{
+    static constexpr uint32 SnapshotMagic = 0x53444250; // "PBDS"
+    static constexpr uint32 SnapshotVersion = 1;
+
+    uint32 Magic = SnapshotMagic;
+    uint32 Version = SnapshotVersion;
+    int32 NumParticles = 0;
+    int32 NumClusters = 0;
+    uint32 LayoutHash = 0;
+
+    // Solver state carried across frames (e.g. constraint multipliers); none yet
+    int32 NumSolverValues = 0;
+};
+
+struct FSoftBodyClusterState
+{
+    FVector CentroidPosition;
+    FVector CentroidVelocity;
+    FVector LastAnimatedCentroid;
+    FVector SleepAnimatedCentroid;
+    int32 StillFrameCount;
+    uint32 bIsSleeping;
+};
+
+struct FSoftBodySnapshot
+{
+    static bool Save(const UPBDSoftBodyComponent& Component, TArray<uint8>& OutData);
+
+    // Fails without touching the component if the snapshot was taken from a different particle layout
+    static bool Restore(UPBDSoftBodyComponent& Component, const TArray<uint8>& Data);
+};
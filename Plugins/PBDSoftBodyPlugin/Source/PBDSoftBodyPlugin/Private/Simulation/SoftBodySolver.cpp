@@ -0,0 +1,637 @@
+#include "PBDSoftBodyPlugin/Private/Simulation/SoftBodySolver.h"
+#include "PBDSoftBodyPlugin/Private/Simulation/ClusterManager.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Async/ParallelFor.h"
+#include "SoftBodyCluster.h"
+
+namespace SoftBodySolver
+{
+    // Greedy coloring tracks used colors in a 64-bit mask per particle; anything beyond lands in a serial bucket
+    static constexpr int32 MaxParallelColors = 64;
+
+    // Below this many items a ParallelFor costs more than it saves
+    static constexpr int32 MinParallelItems = 512;
+
+    // Steps longer than MaxSubstepTime (reduced-rate offscreen ticks, hitches) are split into up to MaxSubsteps substeps,
+    // each clamped to [MinSubstepTime, MaxSubstepTime], so a slow tick covers its whole interval instead of 1/30 s of it
+    static constexpr float MinSubstepTime = 1.0f / 240.0f;
+    static constexpr float MaxSubstepTime = 1.0f / 30.0f;
+    static constexpr int32 MaxSubsteps = 8;
+
+    // Fine-level budget cut when coarse levels run first. A default, not a measured ratio: how many fine iterations the
+    // coarse levels actually save depends on the mesh and its clustering, so check it with PBDSoftBody.Benchmark.Solver
+    // or the replay commandlet before relying on it.
+    static constexpr int32 HierarchicalIterationDivisor = 3;
+
+    // Per-task accumulator for the largest residual seen during a projection pass
+    struct FResidualContext
+    {
+        float MaxResidual = 0.0f;
+    };
+
+    static float ReduceResidual(const TArray<FResidualContext>& Contexts)
+    {
+        float MaxResidual = 0.0f;
+        for (const FResidualContext& Context : Contexts)
+        {
+            MaxResidual = FMath::Max(MaxResidual, Context.MaxResidual);
+        }
+        return MaxResidual;
+    }
+
+    // Returns the XPBD residual |C + alpha * lambda| before the projection (cm); 0 for constraints between pinned particles
+    static FORCEINLINE float ProjectDistance(FVector& PositionA, FVector& PositionB, float InvMassA, float InvMassB, float RestLength, float Alpha, float& Lambda)
+    {
+        const float InvMassSum = InvMassA + InvMassB;
+        if (InvMassSum <= 0.0f)
+        {
+            return 0.0f;
+        }
+        const FVector Delta = PositionA - PositionB;
+        const double Length = Delta.Size();
+        if (Length <= UE_SMALL_NUMBER)
+        {
+            return 0.0f;
+        }
+        const double Residual = Length - RestLength + Alpha * Lambda;
+        const double DeltaLambda = -Residual / (InvMassSum + Alpha);
+        Lambda += static_cast<float>(DeltaLambda);
+        const FVector Correction = Delta * (DeltaLambda / Length);
+        PositionA += Correction * InvMassA;
+        PositionB -= Correction * InvMassB;
+        return static_cast<float>(FMath::Abs(Residual));
+    }
+
+    static FORCEINLINE void ProjectGoal(FVector& Position, const FVector& Goal, float InvMass, float Alpha, float& Lambda)
+    {
+        if (InvMass <= 0.0f)
+        {
+            return;
+        }
+        const FVector Delta = Position - Goal;
+        const double Length = Delta.Size();
+        if (Length <= UE_SMALL_NUMBER)
+        {
+            return;
+        }
+        const double DeltaLambda = (-Length - Alpha * Lambda) / (InvMass + Alpha);
+        Lambda += static_cast<float>(DeltaLambda);
+        Position += Delta * (DeltaLambda * InvMass / Length);
+    }
+
+    static EParallelForFlags GetParallelFlags(int32 NumItems)
+    {
+        return NumItems < MinParallelItems ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+    }
+}
+
+bool USoftBodySolver::Build(UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData, const UClusterManager* ClusterManager)
+{
+    // Simulated sections' triangles in particle space; welded corners already share a particle
+    const FSoftBodyParticleLayout& Layout = Component->ParticleLayout;
+    TArray<int32> ParticleTriangles;
+    if (Layout.IsValid() && LODRenderData.MultiSizeIndexContainer.IsIndexBufferValid())
+    {
+        TArray<uint32> Indices;
+        LODRenderData.MultiSizeIndexContainer.GetIndexBuffer(Indices);
+        for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+        {
+            if (Range.Mode != ESoftBodySectionMode::Simulated)
+            {
+                continue;
+            }
+            const FSkelMeshRenderSection& Section = LODRenderData.RenderSections[Range.SectionIndex];
+            for (uint32 Index = Section.BaseIndex; Index < Section.BaseIndex + Section.NumTriangles * 3; Index++)
+            {
+                ParticleTriangles.Add(Layout.RenderToParticle[Indices[Index]]);
+            }
+        }
+    }
+    return Build(Component, ParticleTriangles, ClusterManager);
+}
+
+bool USoftBodySolver::Build(UPBDSoftBodyComponent* Component, TConstArrayView<int32> ParticleTriangles, const UClusterManager* ClusterManager)
+{
+    Constraints.Reset();
+    ColorOffsets.Reset();
+    Levels.Reset();
+
+    const int32 NumParticles = Component->ParticleLayout.GetNumParticles();
+    if (NumParticles == 0 || Component->SimulatedPositions.Num() != NumParticles || ParticleTriangles.Num() % 3 != 0)
+    {
+        return false;
+    }
+    const TArray<FVector>& RestPositions = Component->SimulatedPositions;
+
+    // Only particles of simulated sections move; rigid ones are pinned to the animation
+    InvMasses.Init(0.0f, NumParticles);
+    for (const FSoftBodySectionRange& Range : Component->SectionRanges)
+    {
+        if (Range.Mode == ESoftBodySectionMode::Simulated)
+        {
+            for (int32 ParticleIdx = Range.FirstParticle; ParticleIdx < Range.FirstParticle + Range.NumParticles; ParticleIdx++)
+            {
+                InvMasses[ParticleIdx] = 1.0f;
+            }
+        }
+    }
+
+    // One constraint per unique particle edge; welded seams collapse to a single edge
+    TSet<uint64> Edges;
+    TArray<FSoftBodyDistanceConstraint> Unsorted;
+    for (int32 Index = 0; Index < ParticleTriangles.Num(); Index += 3)
+    {
+        for (int32 Corner = 0; Corner < 3; Corner++)
+        {
+            const int32 ParticleA = ParticleTriangles[Index + Corner];
+            const int32 ParticleB = ParticleTriangles[Index + (Corner + 1) % 3];
+            if (ParticleA == ParticleB || !InvMasses.IsValidIndex(ParticleA) || !InvMasses.IsValidIndex(ParticleB))
+            {
+                continue;
+            }
+            const int32 Low = FMath::Min(ParticleA, ParticleB);
+            const int32 High = FMath::Max(ParticleA, ParticleB);
+            bool bAlreadyAdded = false;
+            Edges.Add((static_cast<uint64>(Low) << 32) | static_cast<uint32>(High), &bAlreadyAdded);
+            if (!bAlreadyAdded)
+            {
+                Unsorted.Add({ Low, High, static_cast<float>(FVector::Dist(RestPositions[Low], RestPositions[High])) });
+            }
+        }
+    }
+
+    // Greedy coloring, then a counting sort so each color is one contiguous run
+    TArray<uint64> ParticleColors;
+    ParticleColors.Init(0, NumParticles);
+    TArray<int32> ConstraintColors;
+    ConstraintColors.SetNumUninitialized(Unsorted.Num());
+    int32 NumColors = 0;
+    for (int32 ConstraintIdx = 0; ConstraintIdx < Unsorted.Num(); ConstraintIdx++)
+    {
+        const FSoftBodyDistanceConstraint& Constraint = Unsorted[ConstraintIdx];
+        const uint64 Used = ParticleColors[Constraint.A] | ParticleColors[Constraint.B];
+        const int32 Color = Used == MAX_uint64 ? SoftBodySolver::MaxParallelColors : static_cast<int32>(FMath::CountTrailingZeros64(~Used));
+        if (Color < SoftBodySolver::MaxParallelColors)
+        {
+            ParticleColors[Constraint.A] |= 1ull << Color;
+            ParticleColors[Constraint.B] |= 1ull << Color;
+        }
+        ConstraintColors[ConstraintIdx] = Color;
+        NumColors = FMath::Max(NumColors, Color + 1);
+    }
+
+    ColorOffsets.SetNumZeroed(NumColors + 1);
+    for (int32 Color : ConstraintColors)
+    {
+        ColorOffsets[Color + 1]++;
+    }
+    for (int32 Color = 0; Color < NumColors; Color++)
+    {
+        ColorOffsets[Color + 1] += ColorOffsets[Color];
+    }
+    Constraints.SetNumUninitialized(Unsorted.Num());
+    TArray<int32> FillCursor(ColorOffsets.GetData(), NumColors);
+    for (int32 ConstraintIdx = 0; ConstraintIdx < Unsorted.Num(); ConstraintIdx++)
+    {
+        Constraints[FillCursor[ConstraintColors[ConstraintIdx]]++] = Unsorted[ConstraintIdx];
+    }
+
+    // Particle-to-constraint adjacency for the Jacobi gather
+    ParticleConstraintOffsets.SetNumZeroed(NumParticles + 1);
+    for (const FSoftBodyDistanceConstraint& Constraint : Constraints)
+    {
+        ParticleConstraintOffsets[Constraint.A + 1]++;
+        ParticleConstraintOffsets[Constraint.B + 1]++;
+    }
+    for (int32 ParticleIdx = 0; ParticleIdx < NumParticles; ParticleIdx++)
+    {
+        ParticleConstraintOffsets[ParticleIdx + 1] += ParticleConstraintOffsets[ParticleIdx];
+    }
+    ParticleConstraints.SetNumUninitialized(Constraints.Num() * 2);
+    TArray<int32> AdjacencyCursor(ParticleConstraintOffsets.GetData(), NumParticles);
+    for (int32 ConstraintIdx = 0; ConstraintIdx < Constraints.Num(); ConstraintIdx++)
+    {
+        ParticleConstraints[AdjacencyCursor[Constraints[ConstraintIdx].A]++] = ConstraintIdx;
+        ParticleConstraints[AdjacencyCursor[Constraints[ConstraintIdx].B]++] = ConstraintIdx;
+    }
+
+    if (Component->bHierarchicalSolver && ClusterManager)
+    {
+        TArray<TArray<FSoftBodyClusterNode>> Hierarchy;
+        ClusterManager->BuildClusterHierarchy(Component, Component->SolverLevels - 1, Component->ClustersPerSuperCluster, Hierarchy);
+
+        TArray<int32> ParticleNodes;
+        for (const TArray<FSoftBodyClusterNode>& Nodes : Hierarchy)
+        {
+            FSoftBodySolverLevel& Level = Levels.AddDefaulted_GetRef();
+            ParticleNodes.Init(INDEX_NONE, NumParticles);
+            TArray<FVector> RestCentroids;
+            for (int32 NodeIdx = 0; NodeIdx < Nodes.Num(); NodeIdx++)
+            {
+                const FSoftBodyClusterNode& Node = Nodes[NodeIdx];
+                Level.NodeStarts.Add(Node.ParticleStart);
+                Level.NodeCounts.Add(Node.ParticleCount);
+                FVector Centroid = FVector::ZeroVector;
+                for (int32 ParticleIdx = Node.ParticleStart; ParticleIdx < Node.ParticleStart + Node.ParticleCount; ParticleIdx++)
+                {
+                    ParticleNodes[ParticleIdx] = NodeIdx;
+                    Centroid += RestPositions[ParticleIdx];
+                }
+                RestCentroids.Add(Centroid / FMath::Max(Node.ParticleCount, 1));
+            }
+
+            // Nodes are connected wherever a fine edge crosses between them
+            TSet<uint64> NodeEdges;
+            for (const FSoftBodyDistanceConstraint& Constraint : Constraints)
+            {
+                const int32 NodeA = ParticleNodes[Constraint.A];
+                const int32 NodeB = ParticleNodes[Constraint.B];
+                if (NodeA == NodeB || NodeA == INDEX_NONE || NodeB == INDEX_NONE)
+                {
+                    continue;
+                }
+                const int32 Low = FMath::Min(NodeA, NodeB);
+                const int32 High = FMath::Max(NodeA, NodeB);
+                bool bAlreadyAdded = false;
+                NodeEdges.Add((static_cast<uint64>(Low) << 32) | static_cast<uint32>(High), &bAlreadyAdded);
+                if (!bAlreadyAdded)
+                {
+                    Level.Constraints.Add({ Low, High, static_cast<float>(FVector::Dist(RestCentroids[Low], RestCentroids[High])) });
+                }
+            }
+            Level.Positions.SetNumUninitialized(Nodes.Num());
+            Level.Goals.SetNumUninitialized(Nodes.Num());
+            Level.InvMasses.SetNumUninitialized(Nodes.Num());
+        }
+    }
+
+    Lambdas.SetNumZeroed(Constraints.Num());
+    GoalLambdas.SetNumZeroed(NumParticles);
+    StepInvMasses.SetNumUninitialized(NumParticles);
+    GoalPositions.SetNumUninitialized(NumParticles);
+    ResetState(Component);
+
+    if (Component->bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("SoftBodySolver: Built %d distance constraints in %d colors for %d particles, %d coarse levels."),
+            Constraints.Num(), NumColors, NumParticles, Levels.Num());
+    }
+    return Constraints.Num() > 0;
+}
+
+void USoftBodySolver::ResetState(const UPBDSoftBodyComponent* Component)
+{
+    PreviousPositions = Component->SimulatedPositions;
+}
+
+void USoftBodySolver::Step(UPBDSoftBodyComponent* Component, float DeltaTime)
+{
+    const int32 NumParticles = Component->SimulatedPositions.Num();
+    if (NumParticles == 0 || PreviousPositions.Num() != NumParticles || InvMasses.Num() != NumParticles || Component->Velocities.Num() != NumParticles)
+    {
+        return;
+    }
+
+    const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(DeltaTime / SoftBodySolver::MaxSubstepTime), 1, SoftBodySolver::MaxSubsteps);
+    const float Dt = FMath::Clamp(DeltaTime / NumSubsteps, SoftBodySolver::MinSubstepTime, SoftBodySolver::MaxSubstepTime);
+    FVector* Positions = Component->SimulatedPositions.GetData();
+    FVector* Velocities = Component->Velocities.GetData();
+    FMemory::Memcpy(GoalPositions.GetData(), Positions, NumParticles * sizeof(FVector));
+
+    // Sleeping clusters were not rewritten by the blend pass; pin them (and rigid sections) where they are
+    FMemory::Memcpy(StepInvMasses.GetData(), InvMasses.GetData(), NumParticles * sizeof(float));
+    int32 NumUpdatedClusters = 0;
+    for (const FSoftBodyCluster& Cluster : Component->Clusters)
+    {
+        if (Cluster.bUpdatedThisFrame)
+        {
+            NumUpdatedClusters++;
+        }
+        else
+        {
+            FMemory::Memzero(StepInvMasses.GetData() + Cluster.ParticleStart, Cluster.ParticleCount * sizeof(float));
+        }
+    }
+
+    // Every substep pulls toward the same goal, the blended pose at the end of the interval
+    const float InvDt = 1.0f / Dt;
+    const float Damping = Component->SolverDamping;
+    int32 IterationsUsed = 0;
+    for (int32 Substep = 0; Substep < NumSubsteps; Substep++)
+    {
+        ParallelFor(NumParticles, [this, Positions, Velocities, Dt](int32 ParticleIdx)
+        {
+            Positions[ParticleIdx] = StepInvMasses[ParticleIdx] > 0.0f
+                ? PreviousPositions[ParticleIdx] + Velocities[ParticleIdx] * Dt
+                : GoalPositions[ParticleIdx];
+        }, SoftBodySolver::GetParallelFlags(NumParticles));
+
+        // Everything pinned: the predicted positions already are the goals, so there is nothing to iterate
+        if (NumUpdatedClusters > 0)
+        {
+            SolveConstraints(Component, Positions, Dt);
+            IterationsUsed += Component->SimulationStats.SolverIterationsUsed;
+        }
+
+        ParallelFor(NumParticles, [this, Positions, Velocities, InvDt, Damping](int32 ParticleIdx)
+        {
+            Velocities[ParticleIdx] = (Positions[ParticleIdx] - PreviousPositions[ParticleIdx]) * (InvDt * Damping);
+            PreviousPositions[ParticleIdx] = Positions[ParticleIdx];
+        }, SoftBodySolver::GetParallelFlags(NumParticles));
+    }
+    if (NumUpdatedClusters > 0)
+    {
+        Component->SimulationStats.SolverIterationsUsed = IterationsUsed;
+    }
+}
+
+void USoftBodySolver::SolveConstraints(UPBDSoftBodyComponent* Component, FVector* Positions, float Dt)
+{
+    const int32 NumParticles = GoalPositions.Num();
+    FMemory::Memzero(Lambdas.GetData(), Lambdas.Num() * sizeof(float));
+    FMemory::Memzero(GoalLambdas.GetData(), GoalLambdas.Num() * sizeof(float));
+    const float InvDtSq = 1.0f / (Dt * Dt);
+    const float StretchAlpha = Component->StretchCompliance * InvDtSq;
+    const float GoalAlpha = Component->GoalCompliance * InvDtSq;
+
+    // Coarse levels first: they carry low-frequency corrections across the mesh in a few cheap iterations,
+    // leaving the fine level to resolve local detail
+    int32 FineIterations = Component->SolverIterations;
+    if (Levels.Num() > 0)
+    {
+        for (int32 LevelIdx = Levels.Num() - 1; LevelIdx >= 0; LevelIdx--)
+        {
+            SolveCoarseLevel(Levels[LevelIdx], GoalPositions, Positions, Component->SolverIterations, StretchAlpha, GoalAlpha);
+        }
+        FineIterations = FMath::Max(Component->SolverIterations / SoftBodySolver::HierarchicalIterationDivisor, 1);
+    }
+
+    // Adaptive: keep iterating until the largest edge residual drops below the tolerance, within [Min, Max].
+    // The coarse levels cut the adaptive budget by the same factor as the fixed one.
+    const bool bAdaptive = Component->bAdaptiveIterations;
+    const int32 AdaptiveMaxIterations = Levels.Num() > 0
+        ? FMath::Max(Component->MaxSolverIterations / SoftBodySolver::HierarchicalIterationDivisor, 1)
+        : Component->MaxSolverIterations;
+    const int32 MaxIterations = bAdaptive ? AdaptiveMaxIterations : FineIterations;
+    const int32 MinIterations = bAdaptive ? FMath::Min(Component->MinSolverIterations, MaxIterations) : FineIterations;
+    const float Tolerance = Component->ResidualTolerance;
+    const bool bJacobi = Component->SolverMode == ESoftBodySolverMode::Jacobi;
+
+    // Tethers run last in every iteration, so whenever the loop stops no particle is farther than the radius from its skinned position
+    const bool bTethers = Component->bEnableTethers && Component->AnimatedPositions.Num() == NumParticles;
+    const FVector* TetherAnchors = Component->AnimatedPositions.GetData();
+    const float TetherRadius = Component->TetherRadius;
+
+    // Chebyshev semi-iterative weights (omega_1 = 1, omega_2 = 2 / (2 - rho^2), omega_k+1 = 4 / (4 - rho^2 omega_k))
+    const float RhoSq = FMath::Square(Component->ChebyshevRho);
+    float Omega = 1.0f;
+    if (bJacobi)
+    {
+        ConstraintCorrections.SetNumUninitialized(Constraints.Num(), EAllowShrinking::No);
+        ChebyshevOlder.SetNumUninitialized(NumParticles, EAllowShrinking::No);
+        ChebyshevCurrent.SetNumUninitialized(NumParticles, EAllowShrinking::No);
+        FMemory::Memcpy(ChebyshevOlder.GetData(), Positions, NumParticles * sizeof(FVector));
+    }
+
+    // The residual of an iteration is measured while projecting, i.e. it describes the iterate it started from
+    int32 Iteration = 0;
+    float Residual = 0.0f;
+    while (Iteration < MaxIterations)
+    {
+        if (bJacobi)
+        {
+            FMemory::Memcpy(ChebyshevCurrent.GetData(), Positions, NumParticles * sizeof(FVector));
+            Residual = SolveDistanceConstraintsJacobi(Positions, StretchAlpha, Component->JacobiRelaxation);
+            SolveGoalConstraints(Positions, GoalAlpha);
+
+            Omega = Iteration == 0 ? 1.0f : (Iteration == 1 ? 2.0f / (2.0f - RhoSq) : 4.0f / (4.0f - RhoSq * Omega));
+            if (Iteration > 0 && RhoSq > 0.0f)
+            {
+                ApplyChebyshev(Positions, Omega);
+            }
+            if (bTethers)
+            {
+                SolveTetherConstraints(Positions, TetherAnchors, TetherRadius);
+            }
+            Swap(ChebyshevOlder, ChebyshevCurrent);
+        }
+        else
+        {
+            Residual = SolveDistanceConstraints(Positions, StretchAlpha);
+            SolveGoalConstraints(Positions, GoalAlpha);
+            if (bTethers)
+            {
+                SolveTetherConstraints(Positions, TetherAnchors, TetherRadius);
+            }
+        }
+
+        Iteration++;
+        if (bAdaptive && Iteration >= MinIterations && Residual <= Tolerance)
+        {
+            break;
+        }
+    }
+
+    Component->SimulationStats.SolverIterationsUsed = Iteration;
+    Component->SimulationStats.SolverResidual = Residual;
+}
+
+void USoftBodySolver::SolveCoarseLevel(FSoftBodySolverLevel& Level, const TArray<FVector>& Goal, FVector* Positions, int32 Iterations, float StretchAlpha, float GoalAlpha)
+{
+    // Restrict: node position and goal are the means of all their particles, matching the rest centroids the coarse
+    // rest lengths were measured between; only the inverse mass depends on how many of them are free this step
+    const int32 NumNodes = Level.NodeStarts.Num();
+    for (int32 NodeIdx = 0; NodeIdx < NumNodes; NodeIdx++)
+    {
+        FVector Position = FVector::ZeroVector;
+        FVector NodeGoal = FVector::ZeroVector;
+        int32 NumFree = 0;
+        const int32 NodeCount = Level.NodeCounts[NodeIdx];
+        const int32 NodeEnd = Level.NodeStarts[NodeIdx] + NodeCount;
+        for (int32 ParticleIdx = Level.NodeStarts[NodeIdx]; ParticleIdx < NodeEnd; ParticleIdx++)
+        {
+            Position += Positions[ParticleIdx];
+            NodeGoal += Goal[ParticleIdx];
+            NumFree += StepInvMasses[ParticleIdx] > 0.0f ? 1 : 0;
+        }
+        Level.InvMasses[NodeIdx] = NumFree > 0 ? 1.0f / NumFree : 0.0f;
+        Level.Positions[NodeIdx] = NodeCount > 0 ? Position / NodeCount : FVector::ZeroVector;
+        Level.Goals[NodeIdx] = NodeCount > 0 ? NodeGoal / NodeCount : FVector::ZeroVector;
+    }
+    const TArray<FVector> StartPositions = Level.Positions;
+
+    // Few nodes, so plain sequential Gauss-Seidel
+    TArray<float, TInlineAllocator<256>> ConstraintLambdas;
+    ConstraintLambdas.SetNumZeroed(Level.Constraints.Num());
+    TArray<float, TInlineAllocator<128>> NodeGoalLambdas;
+    NodeGoalLambdas.SetNumZeroed(NumNodes);
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        for (int32 ConstraintIdx = 0; ConstraintIdx < Level.Constraints.Num(); ConstraintIdx++)
+        {
+            const FSoftBodyDistanceConstraint& Constraint = Level.Constraints[ConstraintIdx];
+            if (Level.InvMasses[Constraint.A] <= 0.0f && Level.InvMasses[Constraint.B] <= 0.0f)
+            {
+                continue;
+            }
+            SoftBodySolver::ProjectDistance(Level.Positions[Constraint.A], Level.Positions[Constraint.B],
+                Level.InvMasses[Constraint.A], Level.InvMasses[Constraint.B], Constraint.RestLength, StretchAlpha, ConstraintLambdas[ConstraintIdx]);
+        }
+        for (int32 NodeIdx = 0; NodeIdx < NumNodes; NodeIdx++)
+        {
+            // A node's goal spring is its particles' springs in parallel
+            SoftBodySolver::ProjectGoal(Level.Positions[NodeIdx], Level.Goals[NodeIdx], Level.InvMasses[NodeIdx],
+                GoalAlpha * Level.InvMasses[NodeIdx], NodeGoalLambdas[NodeIdx]);
+        }
+    }
+
+    // Prolongate: every free particle of a node takes the node's translation
+    ParallelFor(NumNodes, [this, &Level, &StartPositions, Positions](int32 NodeIdx)
+    {
+        const FVector Delta = Level.Positions[NodeIdx] - StartPositions[NodeIdx];
+        const int32 NodeEnd = Level.NodeStarts[NodeIdx] + Level.NodeCounts[NodeIdx];
+        for (int32 ParticleIdx = Level.NodeStarts[NodeIdx]; ParticleIdx < NodeEnd; ParticleIdx++)
+        {
+            if (StepInvMasses[ParticleIdx] > 0.0f)
+            {
+                Positions[ParticleIdx] += Delta;
+            }
+        }
+    });
+}
+
+float USoftBodySolver::SolveDistanceConstraints(FVector* Positions, float Alpha)
+{
+    float MaxResidual = 0.0f;
+    TArray<SoftBodySolver::FResidualContext> Contexts;
+    const int32 NumColors = ColorOffsets.Num() - 1;
+    for (int32 Color = 0; Color < NumColors; Color++)
+    {
+        const int32 ColorStart = ColorOffsets[Color];
+        const int32 ColorCount = ColorOffsets[Color + 1] - ColorStart;
+        // The overflow bucket may share particles between constraints, so it always runs serially
+        const EParallelForFlags Flags = Color >= SoftBodySolver::MaxParallelColors ? EParallelForFlags::ForceSingleThread : SoftBodySolver::GetParallelFlags(ColorCount);
+        ParallelForWithTaskContext(Contexts, ColorCount, [this, Positions, Alpha, ColorStart](SoftBodySolver::FResidualContext& Context, int32 LocalIdx)
+        {
+            const int32 ConstraintIdx = ColorStart + LocalIdx;
+            const FSoftBodyDistanceConstraint& Constraint = Constraints[ConstraintIdx];
+            const float Residual = SoftBodySolver::ProjectDistance(Positions[Constraint.A], Positions[Constraint.B],
+                StepInvMasses[Constraint.A], StepInvMasses[Constraint.B], Constraint.RestLength, Alpha, Lambdas[ConstraintIdx]);
+            Context.MaxResidual = FMath::Max(Context.MaxResidual, Residual);
+        }, Flags);
+        MaxResidual = FMath::Max(MaxResidual, SoftBodySolver::ReduceResidual(Contexts));
+    }
+    return MaxResidual;
+}
+
+float USoftBodySolver::SolveDistanceConstraintsJacobi(FVector* Positions, float Alpha, float Relaxation)
+{
+    // Every constraint evaluates against the same positions and only writes its own slot
+    TArray<SoftBodySolver::FResidualContext> Contexts;
+    const int32 NumConstraints = Constraints.Num();
+    ParallelForWithTaskContext(Contexts, NumConstraints, [this, Positions, Alpha](SoftBodySolver::FResidualContext& Context, int32 ConstraintIdx)
+    {
+        const FSoftBodyDistanceConstraint& Constraint = Constraints[ConstraintIdx];
+        FVector& Correction = ConstraintCorrections[ConstraintIdx];
+        Correction = FVector::ZeroVector;
+        const float InvMassSum = StepInvMasses[Constraint.A] + StepInvMasses[Constraint.B];
+        if (InvMassSum <= 0.0f)
+        {
+            return;
+        }
+        const FVector Delta = Positions[Constraint.A] - Positions[Constraint.B];
+        const double Length = Delta.Size();
+        if (Length <= UE_SMALL_NUMBER)
+        {
+            return;
+        }
+        const double Residual = Length - Constraint.RestLength + Alpha * Lambdas[ConstraintIdx];
+        const double DeltaLambda = -Residual / (InvMassSum + Alpha);
+        Lambdas[ConstraintIdx] += static_cast<float>(DeltaLambda);
+        Correction = Delta * (DeltaLambda / Length);
+        Context.MaxResidual = FMath::Max(Context.MaxResidual, static_cast<float>(FMath::Abs(Residual)));
+    }, SoftBodySolver::GetParallelFlags(NumConstraints));
+
+    // Each particle gathers its incident corrections and applies their (relaxed) average; it only reads and writes itself
+    const int32 NumParticles = GoalPositions.Num();
+    ParallelFor(NumParticles, [this, Positions, Relaxation](int32 ParticleIdx)
+    {
+        const float InvMass = StepInvMasses[ParticleIdx];
+        const int32 AdjacencyStart = ParticleConstraintOffsets[ParticleIdx];
+        const int32 AdjacencyEnd = ParticleConstraintOffsets[ParticleIdx + 1];
+        if (InvMass <= 0.0f || AdjacencyEnd == AdjacencyStart)
+        {
+            return;
+        }
+        FVector Sum = FVector::ZeroVector;
+        for (int32 Adjacent = AdjacencyStart; Adjacent < AdjacencyEnd; Adjacent++)
+        {
+            const int32 ConstraintIdx = ParticleConstraints[Adjacent];
+            Sum += Constraints[ConstraintIdx].A == ParticleIdx ? ConstraintCorrections[ConstraintIdx] : -ConstraintCorrections[ConstraintIdx];
+        }
+        Positions[ParticleIdx] += Sum * (InvMass * Relaxation / (AdjacencyEnd - AdjacencyStart));
+    }, SoftBodySolver::GetParallelFlags(NumParticles));
+    return SoftBodySolver::ReduceResidual(Contexts);
+}
+
+void USoftBodySolver::ApplyChebyshev(FVector* Positions, float Omega)
+{
+    const int32 NumParticles = GoalPositions.Num();
+    ParallelFor(NumParticles, [this, Positions, Omega](int32 ParticleIdx)
+    {
+        if (StepInvMasses[ParticleIdx] > 0.0f)
+        {
+            const FVector& Older = ChebyshevOlder[ParticleIdx];
+            Positions[ParticleIdx] = Older + (Positions[ParticleIdx] - Older) * Omega;
+        }
+    }, SoftBodySolver::GetParallelFlags(NumParticles));
+}
+
+void USoftBodySolver::SolveGoalConstraints(FVector* Positions, float Alpha)
+{
+    const int32 NumParticles = GoalPositions.Num();
+    ParallelFor(NumParticles, [this, Positions, Alpha](int32 ParticleIdx)
+    {
+        SoftBodySolver::ProjectGoal(Positions[ParticleIdx], GoalPositions[ParticleIdx], StepInvMasses[ParticleIdx], Alpha, GoalLambdas[ParticleIdx]);
+    }, SoftBodySolver::GetParallelFlags(NumParticles));
+}
+
+void USoftBodySolver::SolveTetherConstraints(FVector* Positions, const FVector* Anchors, float Radius)
+{
+    // Unilateral and per particle: only particles beyond the radius move, straight back onto the sphere
+    const int32 NumParticles = GoalPositions.Num();
+    const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+    ParallelFor(NumParticles, [this, Positions, Anchors, Radius, RadiusSq](int32 ParticleIdx)
+    {
+        if (StepInvMasses[ParticleIdx] <= 0.0f)
+        {
+            return;
+        }
+        const FVector Delta = Positions[ParticleIdx] - Anchors[ParticleIdx];
+        const double DistanceSq = Delta.SizeSquared();
+        if (DistanceSq > RadiusSq)
+        {
+            Positions[ParticleIdx] = Anchors[ParticleIdx] + Delta * (Radius / FMath::Sqrt(DistanceSq));
+        }
+    }, SoftBodySolver::GetParallelFlags(NumParticles));
+}
+
+SIZE_T USoftBodySolver::GetTopologyAllocatedSize() const
+{
+    SIZE_T Size = Constraints.GetAllocatedSize() + ColorOffsets.GetAllocatedSize()
+        + ParticleConstraintOffsets.GetAllocatedSize() + ParticleConstraints.GetAllocatedSize()
+        + InvMasses.GetAllocatedSize() + Levels.GetAllocatedSize();
+    for (const FSoftBodySolverLevel& Level : Levels)
+    {
+        Size += Level.NodeStarts.GetAllocatedSize() + Level.NodeCounts.GetAllocatedSize() + Level.Constraints.GetAllocatedSize()
+            + Level.Positions.GetAllocatedSize() + Level.Goals.GetAllocatedSize() + Level.InvMasses.GetAllocatedSize();
+    }
+    return Size;
+}
+
+SIZE_T USoftBodySolver::GetAllocatedSize() const
+{
+    return GetTopologyAllocatedSize() + Lambdas.GetAllocatedSize() + ConstraintCorrections.GetAllocatedSize()
+        + ChebyshevOlder.GetAllocatedSize() + ChebyshevCurrent.GetAllocatedSize() + StepInvMasses.GetAllocatedSize()
+        + GoalLambdas.GetAllocatedSize() + PreviousPositions.GetAllocatedSize() + GoalPositions.GetAllocatedSize();
+}
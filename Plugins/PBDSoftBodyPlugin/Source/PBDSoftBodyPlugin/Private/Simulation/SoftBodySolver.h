@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "PBDSoftBodyComponent.h"
+#include "SoftBodySolver.generated.h"
+
+class FSkeletalMeshLODRenderData;
+class UClusterManager;
+struct FSoftBodyClusterNode;
+
+struct FSoftBodyDistanceConstraint
+{
+    int32 A;
+    int32 B;
+    float RestLength;
+};
+
+// One coarse level of the hierarchy: each node stands for a contiguous particle range and moves it rigidly
+struct FSoftBodySolverLevel
+{
+    TArray<int32> NodeStarts;
+    TArray<int32> NodeCounts;
+    TArray<FSoftBodyDistanceConstraint> Constraints;
+    TArray<FVector> Positions;
+    TArray<FVector> Goals;
+    TArray<float> InvMasses;
+};
+
+// XPBD solver over the component's particles. Each step predicts from the previous solved positions and
+// velocities, pulls particles toward the blended positions (goal constraint) while keeping edge lengths
+// (distance constraints), and writes the result back into SimulatedPositions.
+UCLASS()
+class PBDSOFTBODYPLUGIN_API USoftBodySolver : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Builds edges from the simulated sections' triangles (welded through the particle layout) and the coarse levels
+    bool Build(UPBDSoftBodyComponent* Component, const FSkeletalMeshLODRenderData& LODRenderData, const UClusterManager* ClusterManager);
+
+    // Same, from triangles already in particle space (three particle indices each; INDEX_NONE corners are skipped).
+    // SimulatedPositions hold the rest pose the edge lengths are measured on.
+    bool Build(UPBDSoftBodyComponent* Component, TConstArrayView<int32> ParticleTriangles, const UClusterManager* ClusterManager);
+
+    // Takes the component's current positions as the solved state, e.g. after a snapshot restore
+    void ResetState(const UPBDSoftBodyComponent* Component);
+
+    // Call after the blend pass; SimulatedPositions hold the goal positions on entry and the solved ones on return.
+    // DeltaTime is the whole interval since the last step; long intervals are substepped.
+    void Step(UPBDSoftBodyComponent* Component, float DeltaTime);
+
+    int32 GetNumConstraints() const { return Constraints.Num(); }
+    const TArray<FSoftBodyDistanceConstraint>& GetConstraints() const { return Constraints; }
+    int32 GetNumColors() const { return ColorOffsets.Num() - 1; }
+
+    // Heap bytes held; the topology part (constraints, coloring, adjacency, levels, masses) depends only on mesh and settings
+    SIZE_T GetAllocatedSize() const;
+    SIZE_T GetTopologyAllocatedSize() const;
+
+private:
+    // Coarse levels, then fine iterations (fixed or residual-driven); records the iterations used in the component's stats
+    void SolveConstraints(UPBDSoftBodyComponent* Component, FVector* Positions, float Dt);
+    void SolveCoarseLevel(FSoftBodySolverLevel& Level, const TArray<FVector>& Goal, FVector* Positions, int32 Iterations, float StretchAlpha, float GoalAlpha);
+    // Both distance passes return the largest residual they projected (cm)
+    float SolveDistanceConstraints(FVector* Positions, float Alpha);
+    float SolveDistanceConstraintsJacobi(FVector* Positions, float Alpha, float Relaxation);
+    void ApplyChebyshev(FVector* Positions, float Omega);
+    void SolveGoalConstraints(FVector* Positions, float Alpha);
+
+    // Long-range attachment: clamps every free particle to within Radius of its skinned position
+    void SolveTetherConstraints(FVector* Positions, const FVector* Anchors, float Radius);
+
+    // Distance constraints sorted by color; constraints of one color share no particle and are solved in parallel
+    TArray<FSoftBodyDistanceConstraint> Constraints;
+    TArray<int32> ColorOffsets;
+    TArray<float> Lambdas;
+
+    // Jacobi mode: constraints incident to particle P are ParticleConstraints[ParticleConstraintOffsets[P] .. [P + 1])
+    TArray<int32> ParticleConstraintOffsets;
+    TArray<int32> ParticleConstraints;
+    TArray<FVector> ConstraintCorrections;
+
+    // Chebyshev history: the iterate before the current one, and the current one before its update
+    TArray<FVector> ChebyshevOlder;
+    TArray<FVector> ChebyshevCurrent;
+
+    // Coarse levels, finest (clusters) first; solved coarsest first
+    TArray<FSoftBodySolverLevel> Levels;
+
+    TArray<float> InvMasses;
+    TArray<float> StepInvMasses;
+    TArray<float> GoalLambdas;
+    TArray<FVector> PreviousPositions;
+    TArray<FVector> GoalPositions;
+};
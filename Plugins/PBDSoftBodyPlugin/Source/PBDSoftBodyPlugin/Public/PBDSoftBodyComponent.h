@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "SoftBodyCluster.h"
+#include "SoftBodySimulationStats.h"
+#include "SoftBodySection.h"
+#include "SoftBodyParticleLayout.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "PBDSoftBodyComponent.generated.h"
 
@@ -9,6 +12,73 @@
 class UClusterManager;
 class UVertexBufferUpdater;
 class UAnimationBlender;
+class UVertexDeltaCache;
+class USoftBodySolver;
+class USoftBodyDebugDrawComponent;
+class USoftBodyInstancePool;
+struct FSoftBodyPooledInstance;
+struct FSoftBodyDeltaCacheClusterRange;
+class USoftBodyBoneRecorder;
+class UAnimSequence;
+
+// Heap memory of one component's simulation, by purpose
+struct FSoftBodyMemoryUsage
+{
+    // Per-instance state: particle and cluster arrays, solver state
+    SIZE_T SimulationBytes = 0;
+    // Derived from mesh and settings alone (particle layout, rest offsets, adjacency, solver topology); identical for every instance of a mesh
+    SIZE_T MeshDataBytes = 0;
+    // Render-ordered staging for the vertex buffer upload
+    SIZE_T UploadBytes = 0;
+    // Skinning scratch
+    SIZE_T ScratchBytes = 0;
+    // Delta cache tables and resident chunk
+    SIZE_T CacheBytes = 0;
+
+    SIZE_T GetTotal() const
+    {
+        return SimulationBytes + MeshDataBytes + UploadBytes + ScratchBytes + CacheBytes;
+    }
+
+    FSoftBodyMemoryUsage& operator+=(const FSoftBodyMemoryUsage& Other)
+    {
+        SimulationBytes += Other.SimulationBytes;
+        MeshDataBytes += Other.MeshDataBytes;
+        UploadBytes += Other.UploadBytes;
+        ScratchBytes += Other.ScratchBytes;
+        CacheBytes += Other.CacheBytes;
+        return *this;
+    }
+};
+
+UENUM(BlueprintType)
+enum class ESoftBodyOffscreenMode : uint8
+{
+    // Keep the last simulated state and resume from it when visible again
+    Freeze,
+    // Keep simulating every OffscreenUpdateInterval frames
+    ReducedRate,
+    // Stop simulating and snap back to the animated pose when visible again
+    AnimationOnly
+};
+
+UENUM(BlueprintType)
+enum class ESoftBodySkinningMode : uint8
+{
+    // Blends per-bone dual quaternions; keeps volume at twisting joints, ignores bone scale
+    DualQuaternion,
+    // Blends per-bone matrices, matching the renderer's skinning
+    Linear
+};
+
+UENUM(BlueprintType)
+enum class ESoftBodySolverMode : uint8
+{
+    // Colored constraint batches, each solved in parallel, updating positions in place
+    GaussSeidel,
+    // Every constraint reads the same positions; corrections are averaged per particle and Chebyshev-accelerated
+    Jacobi
+};
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class PBDSOFTBODYPLUGIN_API UPBDSoftBodyComponent : public USkeletalMeshComponent
@@ -20,17 +90,66 @@ public:
     virtual ~UPBDSoftBodyComponent() override;
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+    // Heap memory held by the simulation data and helper objects (not the engine's skeletal mesh resources)
+    void GetMemoryUsage(FSoftBodyMemoryUsage& OutUsage) const;
 
     UFUNCTION(BlueprintCallable, Category = "PBD Soft Body")
     void InitializeConfig();
 
+    // Runs the sim offline over Sequence at SampleRate and writes the result as a vertex-delta cache.
+    // Leaves the component in single-node animation mode playing Sequence.
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Cache")
+    bool BakeDeltaCache(UAnimSequence* Sequence, const FString& FilePath, float SampleRate = 30.0f);
+
+    // Cluster ranges and float rest offsets a delta cache of this component is written and checked against:
+    // the clusters plus one pseudo-cluster per rigid section, in particle order
+    void GetDeltaCacheLayout(TArray<FSoftBodyDeltaCacheClusterRange>& OutRanges, TArray<FVector3f>& OutRestOffsets) const;
+
+    // Captures positions, velocities and cluster state; restore only succeeds on an instance with the same particle layout
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Snapshot")
+    bool SaveSnapshot(TArray<uint8>& OutData) const;
+
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Snapshot")
+    bool RestoreSnapshot(const TArray<uint8>& Data);
+
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Snapshot")
+    bool SaveSnapshotToFile(const FString& FilePath) const;
+
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Snapshot")
+    bool RestoreSnapshotFromFile(const FString& FilePath);
+
+    // Writes the component-space bone transforms skinning reads, once per tick, until StopBoneRecording.
+    // Relative paths are resolved against the project directory. Replay with -run=SoftBodyReplay.
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Replay")
+    bool StartBoneRecording(const FString& FilePath);
+
+    // Returns the number of frames written
+    UFUNCTION(BlueprintCallable, Category = "PBD Soft Body|Replay")
+    int32 StopBoneRecording();
+
+    // While set, skinning reads these instead of the animated pose, as if an animation were playing
+    void SetBoneTransformOverride(const TArray<FTransform>& Transforms);
+    void ClearBoneTransformOverride();
+
+    bool HasBoneTransformOverride() const
+    {
+        return BoneTransformOverride.Num() > 0;
+    }
+
+    // The component-space transforms the skinning pass uses this frame, composed there with the mesh's inverse reference pose
+    const TArray<FTransform>& GetSkinningBoneTransforms() const;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body")
     float SoftBodyBlendWeight;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body")
     int32 NumClusters;
 
+    // Per-particle state, in particle order (see ParticleLayout)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
     TArray<FVector> Velocities;
 
@@ -40,14 +159,169 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
     TArray<FSoftBodyCluster> Clusters;
 
+    // Per render section of LOD 0; sections without an entry are simulated
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Sections")
+    TArray<ESoftBodySectionMode> SectionModes;
+
+    // Merge render vertices duplicated along UV seams, hard normals and section boundaries into a single particle;
+    // vertices only merge with sections of the same mode
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Sections")
+    bool bWeldVertices;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Sections", meta = (ClampMin = "0.0", EditCondition = "bWeldVertices"))
+    float WeldTolerance;
+
+    // How the animated input is skinned on the CPU
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Sections")
+    ESoftBodySkinningMode SkinningMode;
+
+    // Add active morph targets to the skinned input; only vertices touched by non-zero-weight morphs are processed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Sections")
+    bool bApplyMorphTargets;
+
+    // Rebuild normals and tangents from the deformed positions and upload them with the positions
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Rendering")
+    bool bRecomputeTangents;
+
+    // Only recompute vertices whose cluster was updated this frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Rendering", meta = (EditCondition = "bRecomputeTangents"))
+    bool bRecomputeTangentsDirtyOnly;
+
+    // Run the per-particle XPBD solver after the cluster blend; the blended positions become its goal
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver")
+    bool bEnableSolver;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "1", EditCondition = "bEnableSolver"))
+    int32 SolverIterations;
+
+    // XPBD compliance of edge-length constraints (0 = inextensible)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", EditCondition = "bEnableSolver"))
+    float StretchCompliance;
+
+    // XPBD compliance of the pull toward the blended position; larger values let the surface lag and jiggle more
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", EditCondition = "bEnableSolver"))
+    float GoalCompliance;
+
+    // Fraction of velocity kept per step
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bEnableSolver"))
+    float SolverDamping;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (EditCondition = "bEnableSolver"))
+    ESoftBodySolverMode SolverMode;
+
+    // Over-relaxation of the averaged Jacobi corrections
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.1", ClampMax = "2.0", EditCondition = "bEnableSolver && SolverMode == ESoftBodySolverMode::Jacobi"))
+    float JacobiRelaxation;
+
+    // Estimated spectral radius of the Jacobi iteration used by the Chebyshev weights; 0 disables the acceleration
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", ClampMax = "0.9999", EditCondition = "bEnableSolver && SolverMode == ESoftBodySolverMode::Jacobi"))
+    float ChebyshevRho;
+
+    // Keep every particle within TetherRadius of its skinned position; bounds drift so fewer iterations suffice for stiff skin
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (EditCondition = "bEnableSolver"))
+    bool bEnableTethers;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", EditCondition = "bEnableSolver && bEnableTethers"))
+    float TetherRadius;
+
+    // Run fine iterations until the largest edge residual is below ResidualTolerance instead of a fixed count
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (EditCondition = "bEnableSolver"))
+    bool bAdaptiveIterations;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "1", EditCondition = "bEnableSolver && bAdaptiveIterations"))
+    int32 MinSolverIterations;
+
+    // Flat-solver budget; the hierarchical solver divides it like SolverIterations
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "1", EditCondition = "bEnableSolver && bAdaptiveIterations"))
+    int32 MaxSolverIterations;
+
+    // Largest acceptable edge-length residual (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "0.0", EditCondition = "bEnableSolver && bAdaptiveIterations"))
+    float ResidualTolerance;
+
+    // Solve clusters (and super-clusters) before the particles; the fine level then runs a third of SolverIterations.
+    // That cut is a default budget, not a guarantee: check a mesh with PBDSoftBody.Benchmark.Solver or the replay commandlet.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (EditCondition = "bEnableSolver"))
+    bool bHierarchicalSolver;
+
+    // Total levels including the particles: 2 adds clusters, 3 adds super-clusters
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "2", ClampMax = "3", EditCondition = "bEnableSolver && bHierarchicalSolver"))
+    int32 SolverLevels;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Solver", meta = (ClampMin = "2", EditCondition = "bEnableSolver && bHierarchicalSolver"))
+    int32 ClustersPerSuperCluster;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling")
+    bool bEnableClusterSleeping;
+
+    // Centroid movement (cm per frame) below which a cluster counts as still
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling", meta = (ClampMin = "0.0"))
+    float SleepThreshold;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling", meta = (ClampMin = "1"))
+    int32 SleepFrameCount;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling")
+    bool bEnableVisibilityCulling;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling")
+    ESoftBodyOffscreenMode OffscreenMode;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling", meta = (ClampMin = "1"))
+    int32 OffscreenUpdateInterval;
+
+    // Seconds without being rendered before the actor counts as off-screen
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Culling", meta = (ClampMin = "0.0"))
+    float OffscreenTimeout;
+
+    // Decode positions from DeltaCachePath instead of skinning and blending; falls back to simulation if the cache does not match
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Cache")
+    bool bPlayDeltaCache;
+
+    // Absolute, or relative to the project directory
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Cache")
+    FString DeltaCachePath;
+
+    // Frames per memory-mapped chunk when baking
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Cache", meta = (ClampMin = "1"))
+    int32 DeltaCacheFramesPerChunk;
+
+    // Take simulation state from the world's instance pool in BeginPlay and hand it back in EndPlay
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body|Pool")
+    bool bUseInstancePool;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body|Stats")
+    FSoftBodySimulationStats SimulationStats;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body")
     bool bEnableDebugLogging;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PBD Soft Body")
     bool bVerboseDebugLogging;
 
+    ESoftBodySectionMode GetSectionMode(int32 SectionIndex) const;
+
+    // Hash of the settings that shape the built simulation data; pooled instances only match components with the same hash
+    uint32 GetPoolSettingsHash() const;
+
+    // Internal, not exposed to Blueprint
+    TArray<FSoftBodySectionRange> SectionRanges;
+    FSoftBodyParticleLayout ParticleLayout;
+
+    // Skinned positions of the current frame, in particle order
+    TArray<FVector> AnimatedPositions;
+
+    // The sim always runs on LOD 0 render data
+    static constexpr int32 SimulationLODIndex = 0;
+
 protected:
+    void CreateHelpers();
     bool InitializeSimulationData();
+    void AdoptPooledInstance(FSoftBodyPooledInstance& Instance);
+    void MoveToPooledInstance(FSoftBodyPooledInstance& OutInstance);
+    bool OpenDeltaCache();
+    ESoftBodyUpdateTier ComputeUpdateTier() const;
+    void UpdateDebugDraw();
 
 private:
     UPROPERTY(Instanced, Transient)
@@ -59,12 +333,37 @@ private:
     UPROPERTY(Instanced, Transient)
     UAnimationBlender* AnimationBlender;
 
+    UPROPERTY(Transient)
+    UVertexDeltaCache* DeltaCache;
+
+    UPROPERTY(Transient)
+    USoftBodySolver* Solver;
+
+    // Created on demand while PBDSoftBody.DebugDraw is non-zero
+    UPROPERTY(Transient)
+    USoftBodyDebugDrawComponent* DebugDrawComponent;
+
+    // Set between StartBoneRecording and StopBoneRecording
+    UPROPERTY(Transient)
+    USoftBodyBoneRecorder* BoneRecorder;
+
+    TArray<FTransform> BoneTransformOverride;
+
+    float DeltaCacheTime;
+
     bool bHasActiveAnimation;
     mutable bool bHasLoggedVertexCount;
     bool bHasLoggedBlending;
     bool bHasLoggedBlendingVerbose;
     bool bHasLoggedInvalidObjects; // New flag to throttle logging
+    bool bResyncToAnimation;
+    int32 OffscreenFrameCounter;
+
+    // Bone transforms used for the last skinning pass, to skip skinning while fully asleep
+    TArray<FTransform> LastSkinnedBoneTransforms;
 
     friend class UAnimationBlender;
     friend class UVertexBufferUpdater;
+    friend class USoftBodyInstancePool;
+    friend class USoftBodyReplayCommandlet;
 };
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Low-Level Memory Tracker tag for everything the plugin allocates
+LLM_DECLARE_TAG_API(PBDSoftBody, PBDSOFTBODYPLUGIN_API);
 
 class FPBDSoftBodyPluginModule : public IModuleInterface
 {
@@ -11,6 +11,14 @@ struct PBDSOFTBODYPLUGIN_API FSoftBodyCluster
     FSoftBodyCluster()
         : CentroidPosition(FVector::ZeroVector)
         , CentroidVelocity(FVector::ZeroVector)
+        , SectionIndex(INDEX_NONE)
+        , bIsSleeping(false)
+        , ParticleStart(0)
+        , ParticleCount(0)
+        , bUpdatedThisFrame(false)
+        , StillFrameCount(0)
+        , LastAnimatedCentroid(FVector::ZeroVector)
+        , SleepAnimatedCentroid(FVector::ZeroVector)
     {
     }
 
@@ -20,7 +28,31 @@ struct PBDSOFTBODYPLUGIN_API FSoftBodyCluster
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
     FVector CentroidVelocity;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 SectionIndex;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    bool bIsSleeping;
+
     // Internal, not exposed to Blueprint
+    // Render vertices the cluster was built from; only needed until the particle layout is built
     TArray<int32> VertexIndices;
+    // Rest offsets from the centroid, one per particle in [ParticleStart, ParticleStart + ParticleCount)
     TArray<FVector> VertexOffsets;
+    int32 ParticleStart;
+    int32 ParticleCount;
+
+    // Set by the blend pass when the cluster's particles were rewritten this frame
+    bool bUpdatedThisFrame;
+
+    // Sleep tracking: frames spent below the sleep threshold, and the animated centroid the cluster fell asleep at
+    int32 StillFrameCount;
+    FVector LastAnimatedCentroid;
+    FVector SleepAnimatedCentroid;
+
+    void WakeUp()
+    {
+        bIsSleeping = false;
+        StillFrameCount = 0;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Maps simulation particles to render vertices. Particles are stored cluster by cluster (and section by section),
+// so every per-particle array of the sim is contiguous per cluster; render order is only restored when packing.
+struct FSoftBodyParticleLayout
+{
+    // Render vertex each particle was built from, in particle order
+    TArray<int32> ParticleToRenderVertex;
+
+    // Particle each render vertex is packed from; INDEX_NONE for vertices of excluded sections
+    TArray<int32> RenderToParticle;
+
+    // CRC of ParticleToRenderVertex, so saved per-particle state can be checked against the layout it was taken from
+    uint32 LayoutHash = 0;
+
+    int32 GetNumParticles() const
+    {
+        return ParticleToRenderVertex.Num();
+    }
+
+    bool IsValid() const
+    {
+        return ParticleToRenderVertex.Num() > 0;
+    }
+
+    void Reset()
+    {
+        ParticleToRenderVertex.Reset();
+        RenderToParticle.Reset();
+        LayoutHash = 0;
+    }
+};
\ No newline at end of file
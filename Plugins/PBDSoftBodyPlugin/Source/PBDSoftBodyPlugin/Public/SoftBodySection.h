@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SoftBodySection.generated.h"
+
+UENUM(BlueprintType)
+enum class ESoftBodySectionMode : uint8
+{
+    // Clustered, blended and uploaded by the sim
+    Simulated,
+    // Skinned and uploaded, but follows the animation exactly
+    Rigid,
+    // Left to the engine: never skinned, clustered or uploaded by the sim
+    Excluded
+};
+
+// Render section of the simulated LOD; vertices of a section are contiguous in the render vertex buffer
+struct FSoftBodySectionRange
+{
+    FSoftBodySectionRange()
+        : SectionIndex(INDEX_NONE)
+        , FirstVertex(0)
+        , NumVertices(0)
+        , FirstParticle(0)
+        , NumParticles(0)
+        , Mode(ESoftBodySectionMode::Simulated)
+    {
+    }
+
+    int32 SectionIndex;
+    int32 FirstVertex;
+    int32 NumVertices;
+    int32 FirstParticle;
+    int32 NumParticles;
+    ESoftBodySectionMode Mode;
+};
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SoftBodySimulationStats.generated.h"
+
+UENUM(BlueprintType)
+enum class ESoftBodyUpdateTier : uint8
+{
+    Full,
+    ReducedRate,
+    Frozen,
+    AnimationOnly
+};
+
+// Per-frame counters, reset at the start of every tick
+USTRUCT(BlueprintType)
+struct PBDSOFTBODYPLUGIN_API FSoftBodySimulationStats
+{
+    GENERATED_BODY()
+
+    FSoftBodySimulationStats()
+        : UpdateTier(ESoftBodyUpdateTier::Full)
+        , SimulatedVertices(0)
+        , UploadedVertices(0)
+        , AwakeClusters(0)
+        , SleepingClusters(0)
+        , bSkinningSkipped(false)
+        , bPlayedFromCache(false)
+        , MorphedVertices(0)
+        , UpdateTimeMs(0.0f)
+        , SkinTimeMs(0.0f)
+        , UploadTimeMs(0.0f)
+        , SolveTimeMs(0.0f)
+        , SolverIterationsUsed(0)
+        , SolverResidual(0.0f)
+    {
+    }
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    ESoftBodyUpdateTier UpdateTier;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 SimulatedVertices;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 UploadedVertices;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 AwakeClusters;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 SleepingClusters;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    bool bSkinningSkipped;
+
+    // Positions were decoded from a baked vertex-delta cache instead of skinned and blended
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    bool bPlayedFromCache;
+
+    // Render vertices moved by active morph targets this frame
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 MorphedVertices;
+
+    // Game-thread time spent producing positions (skin + blend, or cache decode) and packing/enqueueing the upload
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    float UpdateTimeMs;
+
+    // Part of UpdateTimeMs spent skinning the animated pose
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    float SkinTimeMs;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    float UploadTimeMs;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    float SolveTimeMs;
+
+    // Fine-level solver iterations run this frame over all substeps (0 when every cluster slept) and the largest edge residual (cm) of the last one
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    int32 SolverIterationsUsed;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PBD Soft Body")
+    float SolverResidual;
+
+    void ResetFrameCounters()
+    {
+        SimulatedVertices = 0;
+        UploadedVertices = 0;
+        AwakeClusters = 0;
+        SleepingClusters = 0;
+        bSkinningSkipped = false;
+        bPlayedFromCache = false;
+        MorphedVertices = 0;
+        UpdateTimeMs = 0.0f;
+        SkinTimeMs = 0.0f;
+        UploadTimeMs = 0.0f;
+        SolveTimeMs = 0.0f;
+        SolverIterationsUsed = 0;
+        SolverResidual = 0.0f;
+    }
+};
\ No newline at end of file